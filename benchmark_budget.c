@@ -0,0 +1,471 @@
+/*
+ * Name:       benchmark_budget.c
+ *
+ * Purpose:    Time complete runs of c_budget and keep the results, so the
+ *             speed of one version of c_budget can be compared to another.
+ *
+ *             benchmark_budget is a separate program from c_budget. It runs
+ *             c_budget on a budget data file a number of times, throwing the
+ *             report away, and adds one row to a results file:
+ *                benchmark_budget [options] data_file [c_budget options]
+ *                   -r RUNS          number of runs [3]
+ *                   -o FILE          results file [benchmark_results.tsv]
+ *                   --label LABEL    what is being measured, such as a git
+ *                                    commit [unlabeled]
+ *                   --program PATH   the c_budget to run [./c_budget]
+ *
+ *             Everything after the data file is passed on to c_budget, so
+ *                benchmark_budget --label 2180f57 big.txt -j 4 --stream
+ *             times "./c_budget big.txt -j 4 --stream".
+ *
+ *             The results file is tab separated with a heading line, and
+ *             each row has the label, the data file, the c_budget options,
+ *             the number of lines and bytes in the data file, the number of
+ *             runs, the fastest and average times in seconds, lines/sec and
+ *             MB/sec for the fastest run, the most memory c_budget used in
+ *             any run (peak RSS, in KB) and c_budget's return code.
+ *
+ *             Files made by generate_budget_data are a good place to start.
+ *             benchmark_budget needs fork and exec, so it only works on
+ *             POSIX platforms.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "platform.h"
+#include "boolean.h"
+#include "integer_types.h"
+#include "return_codes.h"
+#include "check_mode.h"
+
+#ifdef POSIX_PLATFORM
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#define MAX_RUNS 1000
+#define MAX_PROGRAM_ARGUMENTS 64
+
+typedef struct {
+   int run_count;
+   const char *results_file_name;
+   const char *label;
+   const char *program_name;
+   const char *data_file_name;
+   char **budget_arguments;
+   int budget_argument_count;
+} Benchmark_options;
+
+int get_benchmark_options(int argument_count, char **argument_vector,
+   Benchmark_options *options);
+int count_data_file(const char *data_file_name, Uint64 *line_count,
+   Uint64 *byte_count);
+int run_budget_program(const Benchmark_options *options, double *seconds,
+   int *return_code);
+long get_peak_memory_kilobytes(void);
+int write_benchmark_result(const Benchmark_options *options,
+   Uint64 line_count, Uint64 byte_count, double best_seconds,
+   double average_seconds, long peak_kilobytes, int budget_return_code);
+
+int main(int argc, char **argv)
+{
+#ifdef POSIX_PLATFORM
+   Benchmark_options options;
+   Uint64 line_count;
+   Uint64 byte_count;
+   double seconds;
+   double best_seconds = 0.0;
+   double total_seconds = 0.0;
+   int budget_return_code = 0;
+   int return_code;
+   int i;
+
+   return_code = get_benchmark_options(argc, argv, &options);
+
+   if(return_code != 0) {
+      return return_code;
+   }
+
+   return_code = count_data_file(options.data_file_name, &line_count,
+      &byte_count);
+
+   if(return_code != 0) {
+      return return_code;
+   }
+
+   for(i = 0; i < options.run_count; i++) {
+      return_code = run_budget_program(&options, &seconds,
+         &budget_return_code);
+
+      if(return_code != 0) {
+         return return_code;
+      }
+
+      if(i == 0 || seconds < best_seconds) {
+         best_seconds = seconds;
+      }
+
+      total_seconds += seconds;
+   }
+
+   return write_benchmark_result(&options, line_count, byte_count,
+      best_seconds, total_seconds / options.run_count,
+      get_peak_memory_kilobytes(), budget_return_code);
+#else
+   (void) argc;
+   (void) argv;
+
+   printf("\nbenchmark_budget only works on POSIX platforms.\n");
+
+   return ARGUMENT_ERROR;
+#endif
+}
+
+#ifdef POSIX_PLATFORM
+
+/*
+ * Fill in options from the command-line arguments.
+ *
+ * Return 0 if they are all valid. Return ARGUMENT_ERROR, otherwise.
+ */
+int get_benchmark_options(int argument_count, char **argument_vector,
+   Benchmark_options *options) {
+
+   int i;
+   long number;
+   char *end_ptr;
+   const char *argument;
+   const char *value;
+
+   options->run_count = 3;
+   options->results_file_name = "benchmark_results.tsv";
+   options->label = "unlabeled";
+   options->program_name = "./c_budget";
+   options->data_file_name = NULL;
+   options->budget_arguments = NULL;
+   options->budget_argument_count = 0;
+
+   for(i = 1; i < argument_count && options->data_file_name == NULL; i++) {
+      argument = argument_vector[i];
+
+      if(argument[0] != '-') {
+         options->data_file_name = argument;
+         options->budget_arguments = argument_vector + i + 1;
+         options->budget_argument_count = argument_count - i - 1;
+
+         continue;
+      }
+
+      value = i + 1 < argument_count ? argument_vector[i + 1] : NULL;
+
+      if(value == NULL) {
+         printf("\n%s must be followed by a value.\n", argument);
+
+         return ARGUMENT_ERROR;
+      }
+
+      i++;
+
+      if(strcmp(argument, "-r") == 0) {
+         number = strtol(value, &end_ptr, 10);
+
+         if(end_ptr == value || *end_ptr != '\0' || number < 1
+            || number > MAX_RUNS) {
+
+            printf("\n-r must be followed by a number of runs from 1 to");
+            printf(" %d.\n", MAX_RUNS);
+
+            return ARGUMENT_ERROR;
+         }
+
+         options->run_count = (int) number;
+      }
+      else if(strcmp(argument, "-o") == 0) {
+         options->results_file_name = value;
+      }
+      else if(strcmp(argument, "--label") == 0) {
+         options->label = value;
+      }
+      else if(strcmp(argument, "--program") == 0) {
+         options->program_name = value;
+      }
+      else {
+         printf("\nUnknown option %s.\n", argument);
+
+         return ARGUMENT_ERROR;
+      }
+   }
+
+   if(options->data_file_name == NULL) {
+      printf("\nUsage: benchmark_budget [-r runs] [-o results_file]");
+      printf(" [--label label]\n");
+      printf("          [--program c_budget] data_file");
+      printf(" [c_budget options]\n");
+
+      return ARGUMENT_ERROR;
+   }
+
+   /*
+    * Room for the program name, the data file and the closing NULL.
+    */
+   if(options->budget_argument_count > MAX_PROGRAM_ARGUMENTS - 3) {
+      printf("\nThere are too many c_budget options.\n");
+
+      return ARGUMENT_ERROR;
+   }
+
+   return 0;
+}
+
+/*
+ * Count the lines and bytes in the data file. A last line without a new line
+ * character is still counted.
+ */
+int count_data_file(const char *data_file_name, Uint64 *line_count,
+   Uint64 *byte_count) {
+
+   FILE *fp;
+   char buffer[65536];
+   size_t length;
+   size_t i;
+   char last = '\n';
+
+   *line_count = 0;
+   *byte_count = 0;
+
+   fp = fopen(data_file_name, "rb");
+
+   if(fp == NULL) {
+      printf("\n%s could not be opened.\n", data_file_name);
+
+      return FILE_ERROR;
+   }
+
+   while((length = fread(buffer, 1, sizeof(buffer), fp)) > 0) {
+      for(i = 0; i < length; i++) {
+         if(buffer[i] == '\n') {
+            (*line_count)++;
+         }
+      }
+
+      *byte_count += length;
+      last = buffer[length - 1];
+   }
+
+   if(ferror(fp)) {
+      printf("\n%s could not be read.\n", data_file_name);
+
+      (void) fclose(fp);
+
+      return FILE_ERROR;
+   }
+
+   (void) fclose(fp);
+
+   if(last != '\n') {
+      (*line_count)++;
+   }
+
+   return 0;
+}
+
+/*
+ * Run c_budget once with its report going to /dev/null, and measure how long
+ * it took from start to finish.
+ *
+ * Return 0 if c_budget ran, even if it returned an error code of its own,
+ * which is put in return_code.
+ */
+int run_budget_program(const Benchmark_options *options, double *seconds,
+   int *return_code) {
+
+   char *arguments[MAX_PROGRAM_ARGUMENTS];
+   double start;
+   pid_t pid;
+   int status;
+   int null_fd;
+   int i;
+
+   arguments[0] = (char *) options->program_name;
+   arguments[1] = (char *) options->data_file_name;
+
+   for(i = 0; i < options->budget_argument_count; i++) {
+      arguments[i + 2] = options->budget_arguments[i];
+   }
+
+   arguments[i + 2] = NULL;
+
+   (void) fflush(stdout);
+
+   start = get_check_seconds();
+   pid = fork();
+
+   if(pid < 0) {
+      printf("\n%s could not be started.\n", options->program_name);
+
+      return FILE_ERROR;
+   }
+
+   if(pid == 0) {
+      null_fd = open("/dev/null", O_WRONLY);
+
+      if(null_fd >= 0) {
+         (void) dup2(null_fd, STDOUT_FILENO);
+         (void) close(null_fd);
+      }
+
+      (void) execv(options->program_name, arguments);
+
+      _exit(127);
+   }
+
+   while(waitpid(pid, &status, 0) < 0) {
+      /*
+       * Only an interrupted wait is tried again.
+       */
+      if(errno != EINTR) {
+         printf("\nThere was an error waiting for %s.\n",
+            options->program_name);
+
+         return FILE_ERROR;
+      }
+   }
+
+   *seconds = get_check_seconds() - start;
+
+   if(WIFEXITED(status) == 0 || WEXITSTATUS(status) == 127) {
+      printf("\n%s could not be run.\n", options->program_name);
+
+      return FILE_ERROR;
+   }
+
+   *return_code = WEXITSTATUS(status);
+
+   return 0;
+}
+
+/*
+ * The most memory used at once by any c_budget run so far, in KB.
+ */
+long get_peak_memory_kilobytes(void) {
+
+   struct rusage usage;
+
+   if(getrusage(RUSAGE_CHILDREN, &usage) != 0) {
+      return 0;
+   }
+
+#if defined(__APPLE__)
+   /*
+    * macOS gives the size in bytes; everywhere else, it is in KB.
+    */
+   return usage.ru_maxrss / 1024;
+#else
+   return usage.ru_maxrss;
+#endif
+}
+
+/*
+ * Add a row to the results file, starting the file with a heading line if it
+ * is new or empty, and print the row.
+ */
+int write_benchmark_result(const Benchmark_options *options,
+   Uint64 line_count, Uint64 byte_count, double best_seconds,
+   double average_seconds, long peak_kilobytes, int budget_return_code) {
+
+   FILE *fp;
+   char budget_options[1024];
+   size_t used = 0;
+   size_t length;
+   double lines_per_second;
+   double megabytes_per_second;
+   int i;
+   Bool write_error = FALSE;
+
+   budget_options[0] = '\0';
+
+   for(i = 0; i < options->budget_argument_count; i++) {
+      length = strlen(options->budget_arguments[i]);
+
+      if(used + length + 2 > sizeof(budget_options)) {
+         break;
+      }
+
+      if(used > 0) {
+         budget_options[used++] = ' ';
+      }
+
+      (void) memcpy(budget_options + used, options->budget_arguments[i],
+         length + 1);
+      used += length;
+   }
+
+   /*
+    * A run too quick to measure is counted as taking a microsecond.
+    */
+   if(best_seconds < 1e-6) {
+      best_seconds = 1e-6;
+   }
+
+   lines_per_second = (double) line_count / best_seconds;
+   megabytes_per_second = (double) byte_count / 1e6 / best_seconds;
+
+   fp = fopen(options->results_file_name, "a");
+
+   if(fp == NULL) {
+      printf("\n%s could not be opened for writing.\n",
+         options->results_file_name);
+
+      return FILE_ERROR;
+   }
+
+   if(fseek(fp, 0, SEEK_END) != 0 || ftell(fp) == 0) {
+      if(fprintf(fp, "label\tdata_file\toptions\tlines\tbytes\truns\t"
+         "best_seconds\taverage_seconds\tlines_per_sec\tmb_per_sec\t"
+         "peak_rss_kb\treturn_code\n") < 0) {
+
+         write_error = TRUE;
+      }
+   }
+
+   if(fprintf(fp, "%s\t%s\t%s\t%.0f\t%.0f\t%d\t%.6f\t%.6f\t%.0f\t%.2f\t"
+      "%ld\t%d\n", options->label, options->data_file_name, budget_options,
+      (double) line_count, (double) byte_count, options->run_count,
+      best_seconds, average_seconds, lines_per_second, megabytes_per_second,
+      peak_kilobytes, budget_return_code) < 0) {
+
+      write_error = TRUE;
+   }
+
+   if(fclose(fp) != 0 || write_error == TRUE) {
+      printf("\nThere was an error writing %s.\n",
+         options->results_file_name);
+
+      return FILE_ERROR;
+   }
+
+   printf("\n%s %s %s: best %.3f seconds, %.0f lines/sec, %.2f MB/sec,",
+      options->label, options->data_file_name, budget_options, best_seconds,
+      lines_per_second, megabytes_per_second);
+   printf(" peak RSS %ld KB\n\n", peak_kilobytes);
+
+   return 0;
+}
+
+#endif
@@ -0,0 +1,51 @@
+#!/bin/sh
+#
+# Name:       benchmark_suite.sh
+#
+# Purpose:    Time c_budget on the same made-up budget data in the same ways
+#             every time, adding the results to benchmark_results.tsv with the
+#             current git commit as the label.
+#
+#             Build c_budget, generate_budget_data and benchmark_budget first
+#             (see README.md), then run this from the same directory:
+#                ./benchmark_suite.sh [largest number of lines]
+#
+#             The data files are only generated once and are kept in
+#             benchmark_data, so later runs compare like with like.
+#
+# Author:     jjones4
+#
+# Copyright (c) 2024 Jerad Jones
+#
+# This file is part of c_budget. c_budget may be freely distributed under the
+# MIT license. For all details and documentation, see:
+#
+#             https://github.com/jjones4/c_budget
+
+set -e
+
+largest=${1:-10000000}
+label=$(git rev-parse --short HEAD 2>/dev/null || echo unlabeled)
+
+mkdir -p benchmark_data
+
+for lines in 1000 1000000 "$largest"; do
+   data=benchmark_data/budget_$lines.txt
+   bad_data=benchmark_data/budget_${lines}_invalid.txt
+
+   if [ ! -f "$data" ]; then
+      ./generate_budget_data -n "$lines" --seed 1 -o "$data"
+   fi
+
+   if [ ! -f "$bad_data" ]; then
+      ./generate_budget_data -n "$lines" --seed 2 --invalid-percent 1 \
+         -o "$bad_data"
+   fi
+
+   ./benchmark_budget --label "$label" "$data"
+   ./benchmark_budget --label "$label" "$data" --stream
+   ./benchmark_budget --label "$label" "$data" -j 4
+   ./benchmark_budget --label "$label" "$data" --check
+   ./benchmark_budget --label "$label" "$data" --categories --top 10
+   ./benchmark_budget --label "$label" "$bad_data" --check --all-errors
+done
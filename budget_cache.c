@@ -0,0 +1,571 @@
+/*
+ * Name:       budget_cache.c
+ *
+ * Purpose:    Keep a binary copy of a budget data file's transactions next to
+ *             it, so that later runs can skip reading and validating the
+ *             text.
+ *
+ *             The cache file is written after the budget file has been read
+ *             without any errors. It holds the dates, amounts and description
+ *             ids in separate columns, followed by each distinct description
+ *             once. A later run memory-maps the cache file and adds the
+ *             transactions straight into the ledger.
+ *
+ *             A cache file is only used if the budget file still has the
+ *             size and modification time it had when the cache was written,
+ *             and every byte of it still hashes to the same value (see
+ *             hash_all in hash.c). Otherwise the budget file is read as usual
+ *             and the cache file is written again.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#include <string.h>
+#include "return_codes.h"
+#include "file_map.h"
+#include "hash.h"
+#include "budget_calculations.h"
+#include "validate_budget_line.h"
+#include "budget_cache.h"
+
+#define CACHE_MAGIC "c_budget"
+#define CACHE_VERSION 2
+#define CACHE_BYTE_ORDER 0x01020304UL
+
+/*
+ * A date is packed into 32 bits as the year, month and day, in that order,
+ * so packed dates sort the same way the dates do.
+ */
+#define PACK_DATE(year, month, day) \
+   (((Uint32) (year) << 9) | ((Uint32) (month) << 5) | (Uint32) (day))
+#define PACKED_YEAR(date) ((int) ((date) >> 9))
+#define PACKED_MONTH(date) ((int) (((date) >> 5) & 0xf))
+#define PACKED_DAY(date) ((int) ((date) & 0x1f))
+
+#define ALIGN_TO_8(offset) (((offset) + 7) & ~(Uint64) 7)
+
+/*
+ * Where each array starts in a cache file, and how long the file is.
+ */
+typedef struct {
+   Uint64 dates_offset;
+   Uint64 amounts_offset;
+   Uint64 ids_offset;
+   Uint64 string_offsets_offset;
+   Uint64 string_bytes_offset;
+   Uint64 length;
+} Cache_layout;
+
+void get_cache_layout(const Cache_header *header, Cache_layout *layout);
+Bool hash_data_file(const char *data_file_name, Uint64 *hash);
+Bool is_valid_cache(const File_map *map, const Cache_header *header,
+   const char *data_file_name);
+int add_cached_transactions(const File_map *map, const Cache_header *header,
+   Ledger *ledger, Bool *loaded);
+void make_cache_file_name(const char *data_file_name, const char *extension,
+   char *cache_file_name);
+Bool flush_cache_writer(Cache_writer *writer);
+Bool write_cache_file(Cache_writer *writer, FILE *fp);
+Bool copy_column(FILE *column_file, FILE *fp, Uint64 *position);
+Bool write_padding(FILE *fp, Uint64 *position);
+
+/*
+ * If data_file_name has an up to date cache file, add its transactions into
+ * ledger and set loaded to TRUE. Otherwise leave ledger alone and set loaded
+ * to FALSE.
+ *
+ * Return 0 if successful. Return MEMORY_ERROR if the ledger could not be
+ * grown.
+ */
+int load_cache(const char *data_file_name, Ledger *ledger, Bool *loaded) {
+
+   char cache_file_name[CACHE_FILE_NAME_LENGTH + 1];
+   File_map map;
+   Cache_header header;
+   int add_cached_transactions_result = 0;
+
+   *loaded = FALSE;
+
+   make_cache_file_name(data_file_name, CACHE_FILE_EXTENSION,
+      cache_file_name);
+
+   if(map_file(cache_file_name, &map) == FALSE) {
+      return 0;
+   }
+
+   if(map.length < sizeof(Cache_header)) {
+      unmap_file(&map);
+
+      return 0;
+   }
+
+   (void) memcpy(&header, map.data, sizeof(Cache_header));
+
+   if(is_valid_cache(&map, &header, data_file_name) == TRUE) {
+      add_cached_transactions_result = add_cached_transactions(&map, &header,
+         ledger, loaded);
+   }
+
+   unmap_file(&map);
+
+   return add_cached_transactions_result;
+}
+
+/*
+ * Start collecting the transactions of data_file_name.
+ *
+ * Return 0 if successful. Return FILE_ERROR if data_file_name is not a
+ * regular file or the temporary files could not be created.
+ */
+int open_cache_writer(Cache_writer *writer, const char *data_file_name) {
+
+   make_cache_file_name(data_file_name, CACHE_FILE_EXTENSION,
+      writer->cache_file_name);
+   (void) strcpy(writer->data_file_name, data_file_name);
+
+   writer->dates_file = NULL;
+   writer->amounts_file = NULL;
+   writer->ids_file = NULL;
+   writer->write_error = FALSE;
+   writer->transaction_count = 0;
+   writer->buffered_rows = 0;
+   init_string_table(&writer->strings);
+
+   if(get_file_status(data_file_name, &writer->source_size,
+      &writer->source_modification_time) == FALSE) {
+
+      return FILE_ERROR;
+   }
+
+   writer->dates_file = tmpfile();
+   writer->amounts_file = tmpfile();
+   writer->ids_file = tmpfile();
+
+   if(writer->dates_file == NULL || writer->amounts_file == NULL
+      || writer->ids_file == NULL) {
+
+      (void) close_cache_writer(writer, FALSE);
+
+      return FILE_ERROR;
+   }
+
+   return 0;
+}
+
+/*
+ * Return 0 if successful. Return MEMORY_ERROR if the description could not
+ * be stored. Problems writing the columns out are only reported by
+ * close_cache_writer.
+ */
+int add_cached_transaction(Cache_writer *writer,
+   const Transaction *transaction) {
+
+   Uint32 id;
+
+   if(intern_string(&writer->strings, transaction->description,
+      transaction->description_length, &id) != 0) {
+
+      return MEMORY_ERROR;
+   }
+
+   writer->dates[writer->buffered_rows] = PACK_DATE(transaction->year,
+      transaction->month, transaction->day);
+   writer->amounts[writer->buffered_rows] = transaction->amount;
+   writer->ids[writer->buffered_rows] = id;
+   writer->transaction_count++;
+
+   if(++writer->buffered_rows == CACHE_WRITER_ROWS) {
+      if(flush_cache_writer(writer) == FALSE) {
+         writer->write_error = TRUE;
+      }
+   }
+
+   return 0;
+}
+
+/*
+ * If keep is TRUE, write the cache file. It is written under a temporary
+ * name and then renamed, so a cache file is never left half written. Either
+ * way, the temporary files and memory used by writer are released.
+ *
+ * Return 0 if successful. Return FILE_ERROR if the cache file could not be
+ * written or the budget file changed while it was being read.
+ */
+int close_cache_writer(Cache_writer *writer, Bool keep) {
+
+   char temporary_file_name[CACHE_FILE_NAME_LENGTH + 1];
+   Uint64 source_size;
+   Int64 source_modification_time;
+   FILE *fp;
+   int return_code = 0;
+
+   if(keep == TRUE) {
+      if(flush_cache_writer(writer) == FALSE
+         || writer->write_error == TRUE
+         || get_file_status(writer->data_file_name, &source_size,
+            &source_modification_time) == FALSE
+         || source_size != writer->source_size
+         || source_modification_time != writer->source_modification_time) {
+
+         return_code = FILE_ERROR;
+      }
+      else {
+         make_cache_file_name(writer->data_file_name,
+            CACHE_FILE_EXTENSION ".tmp", temporary_file_name);
+
+         fp = fopen(temporary_file_name, "wb");
+
+         if(fp == NULL) {
+            return_code = FILE_ERROR;
+         }
+         else {
+            if(write_cache_file(writer, fp) == FALSE) {
+               return_code = FILE_ERROR;
+            }
+
+            if(fclose(fp) != 0) {
+               return_code = FILE_ERROR;
+            }
+
+            /*
+             * rename does not replace an existing file on every platform.
+             */
+            if(return_code == 0) {
+               (void) remove(writer->cache_file_name);
+
+               if(rename(temporary_file_name, writer->cache_file_name) != 0) {
+                  return_code = FILE_ERROR;
+               }
+            }
+
+            if(return_code != 0) {
+               (void) remove(temporary_file_name);
+            }
+         }
+      }
+   }
+
+   if(writer->dates_file != NULL) {
+      (void) fclose(writer->dates_file);
+   }
+
+   if(writer->amounts_file != NULL) {
+      (void) fclose(writer->amounts_file);
+   }
+
+   if(writer->ids_file != NULL) {
+      (void) fclose(writer->ids_file);
+   }
+
+   writer->dates_file = NULL;
+   writer->amounts_file = NULL;
+   writer->ids_file = NULL;
+
+   free_string_table(&writer->strings);
+
+   return return_code;
+}
+
+void get_cache_layout(const Cache_header *header, Cache_layout *layout) {
+
+   layout->dates_offset = sizeof(Cache_header);
+   layout->amounts_offset = ALIGN_TO_8(layout->dates_offset
+      + header->transaction_count * sizeof(Uint32));
+   layout->ids_offset = layout->amounts_offset
+      + header->transaction_count * sizeof(Cents);
+   layout->string_offsets_offset = ALIGN_TO_8(layout->ids_offset
+      + header->transaction_count * sizeof(Uint32));
+   layout->string_bytes_offset = layout->string_offsets_offset
+      + (header->string_count + 1) * sizeof(Uint64);
+   layout->length = layout->string_bytes_offset + header->string_byte_count;
+}
+
+/*
+ * Hash the whole budget file. Hashing is much faster than reading and
+ * validating the text, so this still leaves the cache well worth having.
+ */
+Bool hash_data_file(const char *data_file_name, Uint64 *hash) {
+
+   File_map map;
+
+   if(map_file(data_file_name, &map) == FALSE) {
+      return FALSE;
+   }
+
+   *hash = hash_all(map.data, map.length);
+
+   unmap_file(&map);
+
+   return TRUE;
+}
+
+Bool is_valid_cache(const File_map *map, const Cache_header *header,
+   const char *data_file_name) {
+
+   Uint64 source_size;
+   Int64 source_modification_time;
+   Uint64 source_hash;
+   Cache_layout layout;
+   const Uint64 *string_offsets;
+   Uint64 i;
+
+   if(memcmp(header->magic, CACHE_MAGIC, sizeof(header->magic)) != 0
+      || header->version != CACHE_VERSION
+      || header->byte_order != CACHE_BYTE_ORDER) {
+
+      return FALSE;
+   }
+
+   if(get_file_status(data_file_name, &source_size,
+      &source_modification_time) == FALSE
+      || source_size != header->source_size
+      || source_modification_time != header->source_modification_time
+      || hash_data_file(data_file_name, &source_hash) == FALSE
+      || source_hash != header->source_hash) {
+
+      return FALSE;
+   }
+
+   /*
+    * Make sure the counts are small enough that working out the layout can't
+    * overflow, and that the file is exactly as long as the counts say.
+    */
+   if(header->transaction_count > map->length
+      || header->string_count > map->length
+      || header->string_byte_count > map->length) {
+
+      return FALSE;
+   }
+
+   get_cache_layout(header, &layout);
+
+   if(layout.length != map->length) {
+      return FALSE;
+   }
+
+   string_offsets = (const Uint64 *) (map->data
+      + layout.string_offsets_offset);
+
+   if(string_offsets[0] != 0
+      || string_offsets[header->string_count] != header->string_byte_count) {
+
+      return FALSE;
+   }
+
+   for(i = 0; i < header->string_count; i++) {
+      if(string_offsets[i] > string_offsets[i + 1]) {
+         return FALSE;
+      }
+   }
+
+   return TRUE;
+}
+
+/*
+ * Add every transaction in the cache file into ledger. A transaction that
+ * can't be right means the cache file is damaged, so anything already added
+ * is taken back out and loaded is left FALSE.
+ */
+int add_cached_transactions(const File_map *map, const Cache_header *header,
+   Ledger *ledger, Bool *loaded) {
+
+   Cache_layout layout;
+   const Uint32 *dates;
+   const Cents *amounts;
+   const Uint32 *ids;
+   const Uint64 *string_offsets;
+   const char *string_bytes;
+   Transaction transaction;
+   Uint64 i;
+   int calculate_budget_figures_result = 0;
+
+   get_cache_layout(header, &layout);
+
+   dates = (const Uint32 *) (map->data + layout.dates_offset);
+   amounts = (const Cents *) (map->data + layout.amounts_offset);
+   ids = (const Uint32 *) (map->data + layout.ids_offset);
+   string_offsets = (const Uint64 *) (map->data
+      + layout.string_offsets_offset);
+   string_bytes = map->data + layout.string_bytes_offset;
+
+   for(i = 0; i < header->transaction_count; i++) {
+      transaction.year = PACKED_YEAR(dates[i]);
+      transaction.month = PACKED_MONTH(dates[i]);
+      transaction.day = PACKED_DAY(dates[i]);
+      transaction.amount = amounts[i];
+
+      /*
+       * A damaged cache could hold any date, and a day out of range would be
+       * used as an index by --from/--to and --rolling, so every part of the
+       * date is checked just as it is for a line of text.
+       */
+      if(ids[i] >= header->string_count || transaction.year < 1
+         || transaction.year > 9999 || transaction.month < 1
+         || transaction.month > 12
+         || is_valid_day(transaction.month, transaction.day,
+            transaction.year) == FALSE) {
+
+         free_ledger(ledger);
+
+         return 0;
+      }
+
+      transaction.description = string_bytes + string_offsets[ids[i]];
+      transaction.description_length = (size_t) (string_offsets[ids[i] + 1]
+         - string_offsets[ids[i]]);
+
+      calculate_budget_figures_result = calculate_budget_figures(&transaction,
+         ledger);
+
+      if(calculate_budget_figures_result != 0) {
+         return calculate_budget_figures_result;
+      }
+   }
+
+   *loaded = TRUE;
+
+   return 0;
+}
+
+/*
+ * data_file_name is at most FILE_NAME_LENGTH characters (see program_init.c)
+ * and extension at most 8, so cache_file_name always has room for both.
+ */
+void make_cache_file_name(const char *data_file_name, const char *extension,
+   char *cache_file_name) {
+
+   (void) strcpy(cache_file_name, data_file_name);
+   (void) strcat(cache_file_name, extension);
+}
+
+/*
+ * Write the buffered rows to the column files.
+ */
+Bool flush_cache_writer(Cache_writer *writer) {
+
+   size_t rows = writer->buffered_rows;
+
+   writer->buffered_rows = 0;
+
+   if(rows == 0) {
+      return TRUE;
+   }
+
+   if(fwrite(writer->dates, sizeof(Uint32), rows, writer->dates_file) != rows
+      || fwrite(writer->amounts, sizeof(Cents), rows, writer->amounts_file)
+         != rows
+      || fwrite(writer->ids, sizeof(Uint32), rows, writer->ids_file) != rows) {
+
+      return FALSE;
+   }
+
+   return TRUE;
+}
+
+Bool write_cache_file(Cache_writer *writer, FILE *fp) {
+
+   Cache_header header;
+   Uint64 position = 0;
+   Uint64 string_offset;
+   size_t i;
+
+   (void) memset(&header, 0, sizeof(Cache_header));
+   (void) memcpy(header.magic, CACHE_MAGIC, sizeof(header.magic));
+   header.version = CACHE_VERSION;
+   header.byte_order = CACHE_BYTE_ORDER;
+   header.source_size = writer->source_size;
+   header.source_modification_time = writer->source_modification_time;
+   header.transaction_count = writer->transaction_count;
+   header.string_count = writer->strings.entry_count;
+   header.string_byte_count = writer->strings.byte_count;
+
+   if(hash_data_file(writer->data_file_name, &header.source_hash) == FALSE) {
+      return FALSE;
+   }
+
+   if(fwrite(&header, sizeof(Cache_header), 1, fp) != 1) {
+      return FALSE;
+   }
+
+   position += sizeof(Cache_header);
+
+   if(copy_column(writer->dates_file, fp, &position) == FALSE
+      || write_padding(fp, &position) == FALSE
+      || copy_column(writer->amounts_file, fp, &position) == FALSE
+      || copy_column(writer->ids_file, fp, &position) == FALSE
+      || write_padding(fp, &position) == FALSE) {
+
+      return FALSE;
+   }
+
+   for(i = 0; i < writer->strings.entry_count; i++) {
+      string_offset = writer->strings.entries[i].offset;
+
+      if(fwrite(&string_offset, sizeof(Uint64), 1, fp) != 1) {
+         return FALSE;
+      }
+   }
+
+   string_offset = writer->strings.byte_count;
+
+   if(fwrite(&string_offset, sizeof(Uint64), 1, fp) != 1) {
+      return FALSE;
+   }
+
+   if(writer->strings.byte_count > 0 && fwrite(writer->strings.bytes, 1,
+      writer->strings.byte_count, fp) != writer->strings.byte_count) {
+
+      return FALSE;
+   }
+
+   return TRUE;
+}
+
+/*
+ * Append everything in column_file to fp.
+ */
+Bool copy_column(FILE *column_file, FILE *fp, Uint64 *position) {
+
+   char buffer[8192];
+   size_t bytes_read;
+
+   rewind(column_file);
+
+   while((bytes_read = fread(buffer, 1, sizeof(buffer), column_file)) > 0) {
+      if(fwrite(buffer, 1, bytes_read, fp) != bytes_read) {
+         return FALSE;
+      }
+
+      *position += bytes_read;
+   }
+
+   if(ferror(column_file)) {
+      return FALSE;
+   }
+
+   return TRUE;
+}
+
+/*
+ * Pad fp with zeros up to the next multiple of 8 bytes.
+ */
+Bool write_padding(FILE *fp, Uint64 *position) {
+
+   static const char zeros[8] = { 0 };
+   size_t padding = (size_t) (ALIGN_TO_8(*position) - *position);
+
+   if(padding > 0 && fwrite(zeros, 1, padding, fp) != padding) {
+      return FALSE;
+   }
+
+   *position += padding;
+
+   return TRUE;
+}
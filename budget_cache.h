@@ -0,0 +1,93 @@
+/*
+ * Name:       budget_cache.h
+ *
+ * Purpose:    Typedefs, macros and function definitions for budget_cache.c.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#ifndef BUDGET_CACHE_H
+
+#define BUDGET_CACHE_H
+
+#include <stdio.h>
+#include "boolean.h"
+#include "integer_types.h"
+#include "program_init.h"
+#include "transaction.h"
+#include "ledger.h"
+#include "string_table.h"
+
+/*
+ * The cache file for a budget data file has the same name with this added to
+ * the end.
+ */
+#define CACHE_FILE_EXTENSION ".cbc"
+#define CACHE_FILE_NAME_LENGTH (FILE_NAME_LENGTH + 8)
+
+/*
+ * Number of transactions held in memory before they are written out.
+ */
+#define CACHE_WRITER_ROWS 4096
+
+/*
+ * The start of a cache file. Everything in a cache file is in the byte order
+ * of the computer that wrote it; a cache file from a different kind of
+ * computer is simply rebuilt.
+ *
+ * The header is followed by these arrays, each starting on a multiple of 8
+ * bytes:
+ *    transaction_count packed dates (Uint32, see budget_cache.c)
+ *    transaction_count amounts (Cents)
+ *    transaction_count description ids (Uint32)
+ *    string_count + 1 offsets into the description bytes (Uint64)
+ *    string_byte_count bytes of descriptions
+ */
+typedef struct {
+   char magic[8];
+   Uint32 version;
+   Uint32 byte_order;
+   Uint64 source_size;
+   Int64 source_modification_time;
+   Uint64 source_hash;
+   Uint64 transaction_count;
+   Uint64 string_count;
+   Uint64 string_byte_count;
+} Cache_header;
+
+/*
+ * Collects the transactions of a budget file as it is read. Each column is
+ * written to its own temporary file, and the columns are put together into
+ * the cache file once the whole budget file has been read successfully.
+ */
+typedef struct {
+   char cache_file_name[CACHE_FILE_NAME_LENGTH + 1];
+   char data_file_name[FILE_NAME_LENGTH + 1];
+   Uint64 source_size;
+   Int64 source_modification_time;
+   FILE *dates_file;
+   FILE *amounts_file;
+   FILE *ids_file;
+   Bool write_error;
+   Uint64 transaction_count;
+   size_t buffered_rows;
+   Uint32 dates[CACHE_WRITER_ROWS];
+   Cents amounts[CACHE_WRITER_ROWS];
+   Uint32 ids[CACHE_WRITER_ROWS];
+   String_table strings;
+} Cache_writer;
+
+int load_cache(const char *data_file_name, Ledger *ledger, Bool *loaded);
+int open_cache_writer(Cache_writer *writer, const char *data_file_name);
+int add_cached_transaction(Cache_writer *writer,
+   const Transaction *transaction);
+int close_cache_writer(Cache_writer *writer, Bool keep);
+
+#endif
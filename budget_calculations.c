@@ -1,114 +1,127 @@
-/*
- * Name:       budget_calculations.c
- *
- * Purpose:    Functions for calculating all desired budget figures.
- *
- * Author:     jjones4
- *
- * Copyright (c) 2024 Jerad Jones
- *
- * This file is part of c_budget. c_budget may be freely distributed under the
- * MIT license. For all details and documentation, see:
- *
- *             https://github.com/jjones4/c_budget
- */
-
-/*
- * Any income/gift over $3,000.00 goes into a different table so it doesn't
- * skew my monthly figures or my averages.
- */
-#define LARGE_INCOME_THRESHHOLD 3000.00
-
-/*
- * Any expense over $2,400.00 goes into a different table so it doesn't skew my
- * monthly figures or my averages.
- */
-#define LARGE_EXPENSE_THRESHHOLD (-2400.00)
-
-#include <stdio.h>
-#include <stdlib.h>
-#include "size_limits.h"
-#include "return_codes.h"
-#include "get_data.h"
-
-int calculate_budget_figures(char **line, double *monthly_credits,
-   double *monthly_debits, double *monthly_margins, double
-   *large_amounts_credits, double *large_amounts_debits, double
-   *large_amounts_margins, double *yearly_credits, double *yearly_debits,
-   double *yearly_margins) {
-   
-   int array_index_for_monthly_figures = 0;
-   int array_index_for_yearly_figures = 0;
-   int month = 0; int year = 0;
-   int error_code = 0;
-   double amount = 0.00;
-   char *date_string = NULL;
-   char *amount_string = NULL;
-
-   date_string = malloc(DATE_LENGTH * sizeof(char));
-   amount_string = malloc(AMOUNT_LENGTH_MAX * sizeof(char));
-   
-   if(date_string == NULL || amount_string == NULL) {
-      printf("\nThere was an error getting the required memory.\n");
-
-      return MEMORY_ERROR;
-   }
-
-   get_date_string(*line, date_string);
-   get_amount_string(*line, amount_string);
-
-   month = get_month(date_string, &error_code);
-
-   if(error_code == MEMORY_ERROR) {
-      printf("\nThere was an error getting the required memory.\n");
-
-      free(date_string);
-      free(amount_string);
-
-      return MEMORY_ERROR;
-   }
-
-   year = get_year(date_string, &error_code);
-
-   if(error_code == MEMORY_ERROR) {
-      printf("\nThere was an error getting the required memory.\n");
-
-      free(date_string);
-      free(amount_string);
-
-      return MEMORY_ERROR;
-   }
-   
-   amount = get_amount(amount_string);
-
-   array_index_for_monthly_figures = 12 * (year - START_YEAR) + month - 1;
-   array_index_for_yearly_figures = year - START_YEAR;
-
-   if(amount < -2400.00) {
-      large_amounts_debits[array_index_for_monthly_figures] += amount;
-      large_amounts_margins[array_index_for_monthly_figures] += amount;
-   }
-   else if(amount < 0) {
-      monthly_debits[array_index_for_monthly_figures] += amount;
-      yearly_debits[array_index_for_yearly_figures] += amount;
-
-      monthly_margins[array_index_for_monthly_figures] += amount;
-      yearly_margins[array_index_for_yearly_figures] += amount;
-   }
-   else if(amount < 3000.00) {
-      monthly_credits[array_index_for_monthly_figures] += amount;
-      yearly_credits[array_index_for_yearly_figures] += amount;
-
-      monthly_margins[array_index_for_monthly_figures] += amount;
-      yearly_margins[array_index_for_yearly_figures] += amount;
-   }
-   else {
-      large_amounts_credits[array_index_for_monthly_figures] += amount;
-      large_amounts_margins[array_index_for_monthly_figures] += amount;
-   }
-
-   free(date_string);
-   free(amount_string);
-
-   return 0;
-}
\ No newline at end of file
+/*
+ * Name:       budget_calculations.c
+ *
+ * Purpose:    Functions for calculating all desired budget figures.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+/*
+ * Any income/gift over $3,000.00 goes into a different table so it doesn't
+ * skew my monthly figures or my averages.
+ */
+#define LARGE_INCOME_THRESHHOLD (3000 * CENTS_PER_DOLLAR)
+
+/*
+ * Any expense over $2,400.00 goes into a different table so it doesn't skew my
+ * monthly figures or my averages.
+ */
+#define LARGE_EXPENSE_THRESHHOLD (-2400 * CENTS_PER_DOLLAR)
+
+#include <stddef.h>
+#include "return_codes.h"
+#include "budget_calculations.h"
+
+/*
+ * Where the four bands the thresholds split amounts into are added up in
+ * Month_figures, from the large debits up to the large credits.
+ */
+const size_t month_band_offsets[4] = {
+   offsetof(Month_figures, large_debits),
+   offsetof(Month_figures, debits),
+   offsetof(Month_figures, credits),
+   offsetof(Month_figures, large_credits)
+};
+
+/*
+ * Add the transaction's amount into its month of the ledger (and its band
+ * of the month if the ledger has amount bands), into its day if the ledger
+ * keeps days, and into its category if the ledger keeps categories. A debit
+ * is also counted in its month's sketch if the ledger keeps them, and any
+ * transaction may make the list of largest transactions.
+ *
+ * Return 0 if successful. Return MEMORY_ERROR if the ledger had to grow to
+ * fit the transaction and could not.
+ */
+int calculate_budget_figures(const Transaction *transaction, Ledger *ledger) {
+
+   Cents amount = transaction->amount;
+   Month_figures *month_figures;
+   Day_figures *day_figures;
+   Quantile_sketch *sketch;
+   int band;
+   int i;
+
+   month_figures = get_month_figures(ledger,
+      MONTH_NUMBER(transaction->year, transaction->month));
+
+   if(month_figures == NULL) {
+      return MEMORY_ERROR;
+   }
+
+   /*
+    * The band is the number of thresholds the amount is at or above. Adding
+    * up the comparisons instead of testing them one after another leaves
+    * nothing for the processor to mispredict when large and small, credits
+    * and debits are all mixed together.
+    */
+   band = (amount >= LARGE_EXPENSE_THRESHHOLD) + (amount >= 0)
+      + (amount >= LARGE_INCOME_THRESHHOLD);
+
+   *(Cents *) ((char *) month_figures + month_band_offsets[band]) += amount;
+
+   if(ledger->options.band_count > 0) {
+      band = 0;
+
+      for(i = 0; i < ledger->options.band_count - 1; i++) {
+         band += amount >= ledger->options.band_cutoffs[i];
+      }
+
+      get_band_amounts(ledger, MONTH_NUMBER(transaction->year,
+         transaction->month))[band] += amount;
+   }
+
+   if(ledger->options.days == TRUE) {
+      day_figures = get_day_figures(ledger, DAY_NUMBER(transaction->year,
+         transaction->month, transaction->day));
+
+      if(amount < 0) {
+         day_figures->debits += amount;
+      }
+      else {
+         day_figures->credits += amount;
+      }
+   }
+
+   if(ledger->options.quantiles == TRUE && amount < 0) {
+      sketch = get_month_sketch(ledger,
+         MONTH_NUMBER(transaction->year, transaction->month));
+
+      if(sketch == NULL) {
+         return MEMORY_ERROR;
+      }
+
+      add_to_quantile_sketch(sketch, amount);
+   }
+
+   if(ledger->options.top_count > 0
+      && add_top_transaction(&ledger->top, transaction) != 0) {
+
+      return MEMORY_ERROR;
+   }
+
+   if(ledger->options.categories == TRUE) {
+      return add_to_category(&ledger->categories, transaction->description,
+         transaction->description_length,
+         ledger->options.normalize_categories, amount);
+   }
+
+   return 0;
+}
@@ -0,0 +1,746 @@
+/*
+ * Name:       budget_files.c
+ *
+ * Purpose:    Find and read several budget files at once.
+ *
+ *             Any number of budget files, directories of budget files and
+ *             (where the shell hasn't already expanded them) patterns such as
+ *             budget_2023_*.txt can be given. Each file is read whole by one
+ *             thread into a ledger of its own.
+ *
+ *             Files can be very different sizes, so each thread starts with
+ *             its own share of the files, biggest first, and a thread that
+ *             runs out of files takes one from the end of another thread's
+ *             share. When every file has been read, the ledgers are merged in
+ *             the order the files were given, so the results don't depend on
+ *             which thread read which file.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "platform.h"
+#include "return_codes.h"
+#include "budget_memory.h"
+#include "file_map.h"
+#include "line_reader.h"
+#include "budget_cache.h"
+#include "checkpoint.h"
+#include "budget_files.h"
+
+#ifdef POSIX_PLATFORM
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <glob.h>
+#include <pthread.h>
+#endif
+
+#define INITIAL_FILE_LIST_CAPACITY 64
+
+/*
+ * One budget file and everything that came of reading it.
+ */
+typedef struct {
+   const char *file_name;
+   Uint64 size;
+   Ledger ledger;
+   Error_list *errors;
+   Ingest_result result;
+   int return_code;
+   unsigned long allocation_count;
+} File_job;
+
+/*
+ * The files a thread has left to read. Queue q holds every queue_count'th
+ * job in order of size, starting with the q'th, so its k'th job is
+ * order[q + k * queue_count]. The thread takes its jobs from first onward,
+ * and other threads take them from last backward.
+ */
+typedef struct {
+   int first;
+   int last;
+#ifdef POSIX_PLATFORM
+   pthread_mutex_t lock;
+#endif
+} Job_queue;
+
+/*
+ * Everything shared between the threads. Once a file has failed, files
+ * after it are skipped, since only the first error in file order is
+ * reported.
+ */
+typedef struct {
+   File_job *jobs;
+   int job_count;
+   int *order;
+   Job_queue *queues;
+   int queue_count;
+   Bool allow_mapping;
+   Bool validate_only;
+   int first_failed_job;
+#ifdef POSIX_PLATFORM
+   pthread_mutex_t failure_lock;
+#endif
+} File_pool;
+
+/*
+ * What each thread is given: the pool and which queue is its own.
+ */
+typedef struct {
+   File_pool *pool;
+   int queue;
+} File_worker;
+
+int add_file_name(File_list *list, const char *directory,
+   const char *file_name);
+int add_regular_file(File_list *list, const char *directory,
+   const char *file_name);
+Bool is_data_file_name(const char *file_name);
+Bool has_file_extension(const char *file_name, const char *extension);
+int compare_file_names(const void *first, const void *second);
+void fill_job_queues(File_pool *pool);
+int compare_job_sizes(const void *first, const void *second);
+void read_file_job(File_pool *pool, int job_index);
+void read_jobs_in_order(File_pool *pool);
+unsigned long get_job_allocation_count(const File_pool *pool);
+Bool take_job(File_pool *pool, int queue, int *job_index);
+void *run_file_worker(void *argument);
+void run_file_workers(File_pool *pool);
+
+/*
+ * Only for sorting job indexes by the size of their files.
+ */
+const File_job *sorting_jobs;
+
+void init_file_list(File_list *list) {
+
+   list->names = NULL;
+   list->count = 0;
+   list->capacity = 0;
+   list->growth_count = 0;
+}
+
+void free_file_list(File_list *list) {
+
+   size_t i;
+
+   for(i = 0; i < list->count; i++) {
+      budget_free(list->names[i]);
+   }
+
+   budget_free(list->names);
+
+   init_file_list(list);
+}
+
+#ifdef POSIX_PLATFORM
+
+/*
+ * Return TRUE if argument stands for a group of budget files: a directory,
+ * or a pattern that isn't the name of a file itself.
+ */
+Bool is_file_group(const char *argument) {
+
+   struct stat file_status;
+
+   if(stat(argument, &file_status) == 0) {
+      return S_ISDIR(file_status.st_mode) ? TRUE : FALSE;
+   }
+
+   if(strpbrk(argument, "*?[") != NULL) {
+      return TRUE;
+   }
+
+   return FALSE;
+}
+
+/*
+ * Add the budget files argument stands for to list. A directory stands for
+ * the files in it (but not in directories inside it), sorted by name, and a
+ * pattern stands for the files it matches, leaving out directories and
+ * anything else that isn't a regular file. Anything else is a file name.
+ *
+ * Return 0 if successful. Return FILE_ERROR if a directory can't be read or
+ * nothing matches a pattern, or MEMORY_ERROR if list could not be grown.
+ */
+int add_budget_files(File_list *list, const char *argument) {
+
+   struct stat file_status;
+   DIR *directory;
+   struct dirent *entry;
+   glob_t matches;
+   size_t first_new_name = list->count;
+   size_t i;
+   int return_code = 0;
+
+   if(is_file_group(argument) == FALSE) {
+      return add_file_name(list, NULL, argument);
+   }
+
+   if(stat(argument, &file_status) == 0) {
+      directory = opendir(argument);
+
+      if(directory == NULL) {
+         return FILE_ERROR;
+      }
+
+      while(return_code == 0 && (entry = readdir(directory)) != NULL) {
+         if(is_data_file_name(entry->d_name) == TRUE) {
+            return_code = add_regular_file(list, argument, entry->d_name);
+         }
+      }
+
+      (void) closedir(directory);
+
+      if(return_code == 0) {
+         qsort(&list->names[first_new_name], list->count - first_new_name,
+            sizeof(char *), compare_file_names);
+      }
+
+      return return_code;
+   }
+
+   if(glob(argument, 0, NULL, &matches) != 0) {
+      return FILE_ERROR;
+   }
+
+   for(i = 0; i < matches.gl_pathc && return_code == 0; i++) {
+      return_code = add_regular_file(list, NULL, matches.gl_pathv[i]);
+   }
+
+   globfree(&matches);
+
+   return return_code;
+}
+
+/*
+ * Add file_name to list as add_file_name does, but only if it is a regular
+ * file. Anything else, such as a directory, is quietly left out.
+ *
+ * Return 0 if successful. Return MEMORY_ERROR, otherwise.
+ */
+int add_regular_file(File_list *list, const char *directory,
+   const char *file_name) {
+
+   struct stat file_status;
+   int return_code;
+
+   return_code = add_file_name(list, directory, file_name);
+
+   if(return_code != 0) {
+      return return_code;
+   }
+
+   if(stat(list->names[list->count - 1], &file_status) != 0
+      || S_ISREG(file_status.st_mode) == 0) {
+
+      budget_free(list->names[--list->count]);
+   }
+
+   return 0;
+}
+
+#else
+
+/*
+ * Without POSIX, directories and patterns can't be looked into, so every
+ * argument is a file name.
+ */
+Bool is_file_group(const char *argument) {
+
+   (void) argument;
+
+   return FALSE;
+}
+
+int add_budget_files(File_list *list, const char *argument) {
+
+   return add_file_name(list, NULL, argument);
+}
+
+#endif
+
+/*
+ * Read every file in list, using up to thread_count threads, and merge their
+ * ledgers into ledger in the order of list. If errors isn't NULL, the bad
+ * lines in every file are collected in it instead of stopping at the first
+ * one (see error_list.c). If ledger is NULL, the files are only validated.
+ *
+ * Return 0 if successful. Otherwise, return the applicable error code (see
+ * return_codes.h) for the first file in list that could not be read, with
+ * result filled in for that file alone and result->file_name set to its
+ * name.
+ */
+int ingest_budget_files(const File_list *list, int thread_count,
+   Bool allow_mapping, Ledger *ledger, Error_list *errors,
+   Ingest_result *result) {
+
+   File_pool pool;
+   Error_list *job_errors = NULL;
+   Int64 modification_time;
+   int i;
+   int return_code = 0;
+
+   result->validation_error = 0;
+   result->line_count = 0;
+   result->byte_count = 0;
+   result->file_name = NULL;
+
+   if(list->count == 0) {
+      return 0;
+   }
+
+   if((size_t) thread_count > list->count) {
+      thread_count = (int) list->count;
+   }
+
+   pool.job_count = (int) list->count;
+   pool.queue_count = thread_count;
+   pool.allow_mapping = allow_mapping;
+   pool.validate_only = ledger == NULL ? TRUE : FALSE;
+   pool.first_failed_job = pool.job_count;
+   pool.jobs = budget_malloc(pool.job_count * sizeof(File_job));
+   pool.queues = budget_malloc(pool.queue_count * sizeof(Job_queue));
+   pool.order = budget_malloc(pool.job_count * sizeof(int));
+
+   if(errors != NULL) {
+      job_errors = budget_malloc(pool.job_count * sizeof(Error_list));
+   }
+
+   if(pool.jobs == NULL || pool.queues == NULL || pool.order == NULL
+      || (errors != NULL && job_errors == NULL)) {
+
+      budget_free(pool.jobs);
+      budget_free(pool.queues);
+      budget_free(pool.order);
+      budget_free(job_errors);
+
+      return MEMORY_ERROR;
+   }
+
+   for(i = 0; i < pool.job_count; i++) {
+      pool.jobs[i].file_name = list->names[i];
+      pool.jobs[i].return_code = 0;
+      pool.jobs[i].allocation_count = 0;
+      pool.jobs[i].errors = NULL;
+
+      if(ledger != NULL) {
+         init_ledger(&pool.jobs[i].ledger, &ledger->options);
+      }
+
+      if(job_errors != NULL) {
+         pool.jobs[i].errors = &job_errors[i];
+         init_error_list(pool.jobs[i].errors);
+      }
+
+      if(get_file_status(list->names[i], &pool.jobs[i].size,
+         &modification_time) == FALSE) {
+
+         pool.jobs[i].size = 0;
+      }
+   }
+
+   fill_job_queues(&pool);
+   run_file_workers(&pool);
+
+   for(i = 0; i < pool.job_count; i++) {
+      if(pool.jobs[i].return_code != 0) {
+         *result = pool.jobs[i].result;
+         result->file_name = pool.jobs[i].file_name;
+         return_code = pool.jobs[i].return_code;
+         break;
+      }
+
+      if(ledger != NULL && merge_ledger(ledger, &pool.jobs[i].ledger) != 0) {
+         return_code = MEMORY_ERROR;
+         break;
+      }
+
+      if(pool.jobs[i].errors != NULL) {
+         merge_error_list(errors, pool.jobs[i].errors, pool.jobs[i].file_name,
+            0, 0);
+      }
+
+      result->line_count += pool.jobs[i].result.line_count;
+      result->byte_count += pool.jobs[i].result.byte_count;
+   }
+
+   for(i = 0; i < pool.job_count && ledger != NULL; i++) {
+      free_ledger(&pool.jobs[i].ledger);
+   }
+
+   budget_free(pool.jobs);
+   budget_free(pool.queues);
+   budget_free(pool.order);
+   budget_free(job_errors);
+
+   return return_code;
+}
+
+/*
+ * Add a copy of file_name to list, after directory and a slash if directory
+ * isn't NULL.
+ *
+ * Return 0 if successful. Return MEMORY_ERROR, otherwise.
+ */
+int add_file_name(File_list *list, const char *directory,
+   const char *file_name) {
+
+   char **names;
+   char *name;
+   size_t directory_length = directory != NULL ? strlen(directory) + 1 : 0;
+
+   names = grow_array(list->names, sizeof(char *), list->count,
+      &list->capacity, list->count + 1, INITIAL_FILE_LIST_CAPACITY,
+      &list->growth_count);
+
+   if(names == NULL) {
+      return MEMORY_ERROR;
+   }
+
+   list->names = names;
+
+   name = budget_malloc(directory_length + strlen(file_name) + 1);
+
+   if(name == NULL) {
+      return MEMORY_ERROR;
+   }
+
+   if(directory != NULL) {
+      (void) strcpy(name, directory);
+      name[directory_length - 1] = '/';
+   }
+
+   (void) strcpy(name + directory_length, file_name);
+
+   list->names[list->count++] = name;
+
+   return 0;
+}
+
+/*
+ * Files in a directory are skipped if they are hidden, or are c_budget's
+ * own cache and checkpoint files, including the temporary ones they are
+ * written to first.
+ */
+Bool is_data_file_name(const char *file_name) {
+
+   if(file_name[0] == '.'
+      || has_file_extension(file_name, CACHE_FILE_EXTENSION) == TRUE
+      || has_file_extension(file_name, CACHE_FILE_EXTENSION ".tmp") == TRUE
+      || has_file_extension(file_name, CHECKPOINT_FILE_EXTENSION) == TRUE
+      || has_file_extension(file_name, CHECKPOINT_FILE_EXTENSION ".tmp")
+         == TRUE) {
+
+      return FALSE;
+   }
+
+   return TRUE;
+}
+
+Bool has_file_extension(const char *file_name, const char *extension) {
+
+   size_t length = strlen(file_name);
+   size_t extension_length = strlen(extension);
+
+   if(length >= extension_length && strcmp(file_name + length
+      - extension_length, extension) == 0) {
+
+      return TRUE;
+   }
+
+   return FALSE;
+}
+
+int compare_file_names(const void *first, const void *second) {
+
+   return strcmp(*(char * const *) first, *(char * const *) second);
+}
+
+/*
+ * Deal the files out to the queues like cards, biggest first, so each queue
+ * starts with about the same amount of data and its biggest files at the
+ * front.
+ */
+void fill_job_queues(File_pool *pool) {
+
+   int queue;
+   int i;
+
+   for(i = 0; i < pool->job_count; i++) {
+      pool->order[i] = i;
+   }
+
+   sorting_jobs = pool->jobs;
+   qsort(pool->order, pool->job_count, sizeof(int), compare_job_sizes);
+
+   for(queue = 0; queue < pool->queue_count; queue++) {
+      pool->queues[queue].first = 0;
+      pool->queues[queue].last = (pool->job_count - queue
+         + pool->queue_count - 1) / pool->queue_count;
+   }
+}
+
+/*
+ * Bigger files first. Files the same size stay in file order.
+ */
+int compare_job_sizes(const void *first, const void *second) {
+
+   int first_index = *(const int *) first;
+   int second_index = *(const int *) second;
+   Uint64 first_size = sorting_jobs[first_index].size;
+   Uint64 second_size = sorting_jobs[second_index].size;
+
+   if(first_size != second_size) {
+      return first_size > second_size ? -1 : 1;
+   }
+
+   return first_index - second_index;
+}
+
+/*
+ * Read one file into its job's ledger.
+ */
+void read_file_job(File_pool *pool, int job_index) {
+
+   File_job *job = &pool->jobs[job_index];
+   Line_reader reader;
+   int open_line_reader_result;
+
+   job->result.validation_error = 0;
+   job->result.line_count = 0;
+   job->result.byte_count = 0;
+   job->result.file_name = NULL;
+
+   open_line_reader_result = open_line_reader(&reader, job->file_name,
+      pool->allow_mapping);
+
+   job->allocation_count = reader.allocation_count;
+
+   if(open_line_reader_result != 0) {
+      job->return_code = open_line_reader_result == MEMORY_ERROR
+         ? MEMORY_ERROR : FILE_ERROR;
+      return;
+   }
+
+   job->return_code = read_budget_lines(&reader,
+      pool->validate_only == TRUE ? NULL : &job->ledger, NULL, job->errors,
+      &job->result);
+
+   close_line_reader(&reader);
+}
+
+/*
+ * Read the files one after another, stopping at the first that fails.
+ */
+void read_jobs_in_order(File_pool *pool) {
+
+   int i;
+
+   for(i = 0; i < pool->job_count; i++) {
+      read_file_job(pool, i);
+
+      if(pool->jobs[i].return_code != 0) {
+         break;
+      }
+   }
+}
+
+/*
+ * The number of allocations reading the files is allowed to have made so
+ * far: one to open each file read in blocks, and one each time a ledger
+ * grows. Reading the lines themselves must never allocate, no matter how
+ * many threads are reading (see ingest_budget_lines).
+ */
+unsigned long get_job_allocation_count(const File_pool *pool) {
+
+   unsigned long allocation_count = 0;
+   int i;
+
+   for(i = 0; i < pool->job_count; i++) {
+      allocation_count += pool->jobs[i].allocation_count;
+
+      if(pool->validate_only == FALSE) {
+         allocation_count += get_ledger_growth_count(&pool->jobs[i].ledger);
+      }
+   }
+
+   return allocation_count;
+}
+
+#ifdef POSIX_PLATFORM
+
+/*
+ * Give each queue its own thread. The first queue's thread is the calling
+ * thread. If a thread can't be started, its queue is simply left for the
+ * other threads to take from.
+ */
+void run_file_workers(File_pool *pool) {
+
+   int i;
+   pthread_t *threads;
+   Bool *thread_started;
+   File_worker *workers;
+   unsigned long allocation_count_before_reading;
+   unsigned long job_allocation_count_before_reading;
+
+   threads = budget_malloc(pool->queue_count * sizeof(pthread_t));
+   thread_started = budget_malloc(pool->queue_count * sizeof(Bool));
+   workers = budget_malloc(pool->queue_count * sizeof(File_worker));
+
+   (void) pthread_mutex_init(&pool->failure_lock, NULL);
+
+   for(i = 0; i < pool->queue_count; i++) {
+      (void) pthread_mutex_init(&pool->queues[i].lock, NULL);
+   }
+
+   allocation_count_before_reading = get_allocation_count();
+   job_allocation_count_before_reading = get_job_allocation_count(pool);
+
+   if(threads == NULL || thread_started == NULL || workers == NULL) {
+      read_jobs_in_order(pool);
+   }
+   else {
+      for(i = 0; i < pool->queue_count; i++) {
+         workers[i].pool = pool;
+         workers[i].queue = i;
+         thread_started[i] = FALSE;
+
+         if(i > 0 && pthread_create(&threads[i], NULL, run_file_worker,
+            &workers[i]) == 0) {
+
+            thread_started[i] = TRUE;
+         }
+      }
+
+      (void) run_file_worker(&workers[0]);
+
+      for(i = 1; i < pool->queue_count; i++) {
+         if(thread_started[i] == TRUE) {
+            (void) pthread_join(threads[i], NULL);
+         }
+      }
+   }
+
+   assert(get_allocation_count() - allocation_count_before_reading
+      == get_job_allocation_count(pool)
+      - job_allocation_count_before_reading);
+
+   for(i = 0; i < pool->queue_count; i++) {
+      (void) pthread_mutex_destroy(&pool->queues[i].lock);
+   }
+
+   (void) pthread_mutex_destroy(&pool->failure_lock);
+
+   budget_free(threads);
+   budget_free(thread_started);
+   budget_free(workers);
+}
+
+/*
+ * Read files from the worker's own queue, then from the other queues, until
+ * there are none left.
+ */
+void *run_file_worker(void *argument) {
+
+   File_worker *worker = argument;
+   File_pool *pool = worker->pool;
+   int job_index;
+   Bool skip;
+
+   while(take_job(pool, worker->queue, &job_index) == TRUE) {
+      (void) pthread_mutex_lock(&pool->failure_lock);
+      skip = job_index > pool->first_failed_job ? TRUE : FALSE;
+      (void) pthread_mutex_unlock(&pool->failure_lock);
+
+      if(skip == TRUE) {
+         continue;
+      }
+
+      read_file_job(pool, job_index);
+
+      if(pool->jobs[job_index].return_code != 0) {
+         (void) pthread_mutex_lock(&pool->failure_lock);
+
+         if(job_index < pool->first_failed_job) {
+            pool->first_failed_job = job_index;
+         }
+
+         (void) pthread_mutex_unlock(&pool->failure_lock);
+      }
+   }
+
+   return NULL;
+}
+
+/*
+ * Take the next job from the front of the worker's own queue or, if it is
+ * empty, from the back of the next queue that isn't. Return FALSE if every
+ * queue is empty.
+ */
+Bool take_job(File_pool *pool, int queue, int *job_index) {
+
+   Job_queue *own = &pool->queues[queue];
+   Job_queue *victim;
+   int victim_queue;
+   Bool taken = FALSE;
+   int i;
+
+   (void) pthread_mutex_lock(&own->lock);
+
+   if(own->first < own->last) {
+      *job_index = pool->order[queue + own->first++ * pool->queue_count];
+      taken = TRUE;
+   }
+
+   (void) pthread_mutex_unlock(&own->lock);
+
+   for(i = 1; i < pool->queue_count && taken == FALSE; i++) {
+      victim_queue = (queue + i) % pool->queue_count;
+      victim = &pool->queues[victim_queue];
+
+      (void) pthread_mutex_lock(&victim->lock);
+
+      if(victim->first < victim->last) {
+         *job_index = pool->order[victim_queue
+            + --victim->last * pool->queue_count];
+         taken = TRUE;
+      }
+
+      (void) pthread_mutex_unlock(&victim->lock);
+   }
+
+   return taken;
+}
+
+#else
+
+/*
+ * Without POSIX threads, the files are simply read one after another.
+ */
+void run_file_workers(File_pool *pool) {
+
+   unsigned long allocation_count_before_reading = get_allocation_count();
+   unsigned long job_allocation_count_before_reading
+      = get_job_allocation_count(pool);
+
+   read_jobs_in_order(pool);
+
+   assert(get_allocation_count() - allocation_count_before_reading
+      == get_job_allocation_count(pool)
+      - job_allocation_count_before_reading);
+}
+
+#endif
@@ -0,0 +1,44 @@
+/*
+ * Name:       budget_files.h
+ *
+ * Purpose:    Typedefs and function definitions for budget_files.c.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#ifndef BUDGET_FILES_H
+
+#define BUDGET_FILES_H
+
+#include <stddef.h>
+#include "boolean.h"
+#include "ledger.h"
+#include "ingest_budget_data.h"
+
+/*
+ * The names of the budget files to be read together, in the order their
+ * ledgers are merged.
+ */
+typedef struct {
+   char **names;
+   size_t count;
+   size_t capacity;
+   unsigned long growth_count;
+} File_list;
+
+void init_file_list(File_list *list);
+void free_file_list(File_list *list);
+Bool is_file_group(const char *argument);
+int add_budget_files(File_list *list, const char *argument);
+int ingest_budget_files(const File_list *list, int thread_count,
+   Bool allow_mapping, Ledger *ledger, Error_list *errors,
+   Ingest_result *result);
+
+#endif
@@ -0,0 +1,125 @@
+/*
+ * Name:       budget_memory.c
+ *
+ * Purpose:    Wrappers around the standard allocation functions. All of
+ *             c_budget's heap allocations go through here so that the number
+ *             of allocations can be counted.
+ *
+ *             Reading, validating and adding up a line of budget data must not
+ *             allocate anything. Every way of reading budget data asserts
+ *             this: ingest_budget_lines for a single reader, run_chunks for
+ *             a file split between threads and run_file_workers for several
+ *             files. Each compares the count before and after reading with
+ *             the number of times the ledgers were allowed to grow.
+ *             self_test.sh runs all three.
+ *
+ *             Threads reading a budget file in parallel can each allocate
+ *             when their ledger grows, so the count is kept under a lock.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdlib.h>
+#include <string.h>
+#include "platform.h"
+#include "budget_memory.h"
+
+#ifdef POSIX_PLATFORM
+#include <pthread.h>
+
+pthread_mutex_t allocation_count_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+unsigned long allocation_count = 0;
+
+void *budget_malloc(size_t size) {
+
+#ifdef POSIX_PLATFORM
+   (void) pthread_mutex_lock(&allocation_count_lock);
+   ++allocation_count;
+   (void) pthread_mutex_unlock(&allocation_count_lock);
+#else
+   ++allocation_count;
+#endif
+
+   return malloc(size);
+}
+
+void budget_free(void *ptr) {
+
+   free(ptr);
+}
+
+unsigned long get_allocation_count(void) {
+
+   unsigned long count;
+
+#ifdef POSIX_PLATFORM
+   (void) pthread_mutex_lock(&allocation_count_lock);
+   count = allocation_count;
+   (void) pthread_mutex_unlock(&allocation_count_lock);
+#else
+   count = allocation_count;
+#endif
+
+   return count;
+}
+
+/*
+ * Make sure array has room for needed elements (at least one), at least
+ * doubling it if it doesn't. The first used elements are kept, and
+ * growth_count is increased for each allocation.
+ *
+ * Return the array, which has moved if it was grown. Return NULL if it could
+ * not be grown, in which case array is left as it was.
+ */
+void *grow_array(void *array, size_t element_size, size_t used,
+   size_t *capacity, size_t needed, size_t initial_capacity,
+   unsigned long *growth_count) {
+
+   size_t new_capacity;
+   void *new_array;
+
+   if(needed == 0) {
+      needed = 1;
+   }
+
+   if(needed <= *capacity) {
+      return array;
+   }
+
+   new_capacity = 2 * *capacity;
+
+   if(new_capacity < initial_capacity) {
+      new_capacity = initial_capacity;
+   }
+
+   if(new_capacity < needed) {
+      new_capacity = needed;
+   }
+
+   new_array = budget_malloc(new_capacity * element_size);
+
+   if(new_array == NULL) {
+      return NULL;
+   }
+
+   if(array != NULL) {
+      (void) memcpy(new_array, array, used * element_size);
+      budget_free(array);
+   }
+
+   *capacity = new_capacity;
+   (*growth_count)++;
+
+   return new_array;
+}
@@ -0,0 +1,29 @@
+/*
+ * Name:       budget_memory.h
+ *
+ * Purpose:    Function definitions for budget_memory.c.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#ifndef BUDGET_MEMORY_H
+
+#define BUDGET_MEMORY_H
+
+#include <stddef.h>
+
+void *budget_malloc(size_t size);
+void budget_free(void *ptr);
+unsigned long get_allocation_count(void);
+void *grow_array(void *array, size_t element_size, size_t used,
+   size_t *capacity, size_t needed, size_t initial_capacity,
+   unsigned long *growth_count);
+
+#endif
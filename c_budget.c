@@ -1,158 +1,509 @@
-/*
- * Name:       c_budget.c
- *
- * Purpose:    Main program source file
- *
- *             c_budget is a simple command-line budget app which validates and
- *             displays budget figures. The budget data is stored in a text
- *             file called budget_data.txt. Additionally, a custom file name
- *             can be used. c_budget can display figures such as monthly and
- *             yearly income and expenses and show how much over or under
- *             budget you were for those time periods.
- *
- *             c_budget is run from the command line with no arguments after
- *             the program name or with one argument after the program name, as
- *             shown below:
- *                1. c_budget
- *                2. c_budget my_budget_data.txt
- *
- *             If no arguments are provided, c_budget uses the file defined in
- *             the macro DEFAULT_DATA_FILE. If the user enters a user-defined
- *             name for the data file, c_budget will attempt to use it.
- *
- *             c_budget is designed  to be C89 compliant. Therefore, it does
- *             not utilize <stdbool.h>, variable length arrays, double forward
- *             slashes for comments, etc.
- *
- * Author:     jjones4
- *
- * Copyright (c) 2024 Jerad Jones
- *
- * This file is part of c_budget. c_budget may be freely distributed under the
- * MIT license. For all details and documentation, see:
- *
- *             https://github.com/jjones4/c_budget
- */
-
-#include <stdlib.h>
-#include "size_limits.h"
-#include "return_codes.h"
-#include "program_init.h"
-#include "validate_budget_line.h"
-#include "budget_calculations.h"
-#include "print_budget_figures.h"
-
-#define MAX_NUMBER_OF_TRANSACTIONS 1000000
-
-int main(int argc, char **argv)
-{
-   FILE *fp;
-   char *line;
-   char *data_file_name;
-   int line_number = 0;
-   int program_init_result = 0;
-   int validate_budget_line_result = 0;
-   int calculate_budget_figures_result = 0;
-   double monthly_debits[NUMBER_OF_MONTHS] = {0.00};
-   double monthly_credits[NUMBER_OF_MONTHS] = {0.00};
-   double monthly_margins[NUMBER_OF_MONTHS] = {0.00};
-   double large_amounts_credits[NUMBER_OF_MONTHS] = {0.00};
-   double large_amounts_debits[NUMBER_OF_MONTHS] = {0.00};
-   double large_amounts_margins[NUMBER_OF_MONTHS] = {0.00};
-   double yearly_debits[NUMBER_OF_YEARS] = {0.00};
-   double yearly_credits[NUMBER_OF_YEARS] = {0.00};
-   double yearly_margins[NUMBER_OF_YEARS] = {0.00};
-
-   data_file_name = malloc(FILE_NAME_LENGTH + 1);
-
-   if(data_file_name == NULL) {
-         printf("\nThere was an error getting the required memory.\n");
-
-         return MEMORY_ERROR;
-   }
-
-   /*
-    * Ensure program initialization is successful. If successful,
-    * data_file_name will point to the budget data file. If not, return
-    * appropriate error code.
-    */
-   program_init_result = program_init(argc, argv, &data_file_name);
-
-   if(program_init_result != 0) {
-      free(data_file_name);
-      return program_init_result;
-   }
-
-   fp = fopen(data_file_name, "r");
-
-   if(fp == NULL) {
-      printf("\nFile could not be opened. Please ensure %s ", data_file_name);
-      printf("exists, and try again.\n");
-
-      free(data_file_name);
-      return FILE_ERROR;
-   }
-
-   /*
-    * Get each line from budget data file. Perform validation checks and
-    * calculations.
-    */
-   for(;;) {
-      if(line_number > MAX_NUMBER_OF_TRANSACTIONS) {
-         printf("\nToo much data was found in the budget data file.\n");
-
-         free(data_file_name);
-         return DATA_SIZE_ERROR;
-      }
-
-      line = malloc(LINE_BUFFER_SIZE * sizeof(char));
-
-      if(line == NULL) {
-         printf("\nThere was an error getting the required memory.\n");
-
-         free(data_file_name);
-         return MEMORY_ERROR;
-      }
-
-      if(fgets(line, LINE_BUFFER_SIZE - 1, fp) == NULL) {
-         free(line);
-         
-         break;
-      }
-
-      validate_budget_line_result = validate_budget_line(&line, line_number);
-
-      if(validate_budget_line_result != 0) {
-         free(line);
-         free(data_file_name);
-
-         return validate_budget_line_result;
-      }
-
-      calculate_budget_figures_result = calculate_budget_figures(&line,
-         monthly_credits, monthly_debits, monthly_margins,
-         large_amounts_credits, large_amounts_debits, large_amounts_margins,
-         yearly_credits, yearly_debits, yearly_margins);
-
-      if(calculate_budget_figures_result != 0) {
-         free(line);
-         free(data_file_name);
-
-         return calculate_budget_figures_result;
-      }
-
-      line_number++;
-
-      free(line);
-   }
-
-   display_budget_figures(monthly_credits, monthly_debits, monthly_margins,
-         large_amounts_credits, large_amounts_debits, large_amounts_margins,
-         yearly_credits, yearly_debits, yearly_margins);
-
-   fclose(fp);
-
-   free(data_file_name);
-
-   return 0;
-}
+/*
+ * Name:       c_budget.c
+ *
+ * Purpose:    Main program source file
+ *
+ *             c_budget is a simple command-line budget app which validates and
+ *             displays budget figures. The budget data is stored in a text
+ *             file called budget_data.txt. Additionally, a custom file name
+ *             can be used. c_budget can display figures such as monthly and
+ *             yearly income and expenses and show how much over or under
+ *             budget you were for those time periods.
+ *
+ *             c_budget is run from the command line with no arguments after
+ *             the program name or with the options and file names shown below:
+ *                1. c_budget
+ *                2. c_budget my_budget_data.txt
+ *                3. c_budget -
+ *                4. c_budget -j 8 my_budget_data.txt
+ *                5. c_budget --stream my_budget_data.txt
+ *                6. c_budget --cache my_budget_data.txt
+ *                7. c_budget --incremental my_budget_data.txt
+ *                8. c_budget --follow my_budget_data.txt
+ *                9. c_budget --categories my_budget_data.txt
+ *               10. c_budget --from 01/01/2023 --to 06/30/2023 budget.txt
+ *               11. c_budget --top 10 my_budget_data.txt
+ *               12. c_budget --quantiles my_budget_data.txt
+ *               13. c_budget --rolling my_budget_data.txt
+ *               14. c_budget --bands -500.00,0.00,500.00 my_budget_data.txt
+ *               15. c_budget -j 8 budget_2022.txt budget_2023.txt budget_dir
+ *               16. c_budget -o my_budget_report.txt my_budget_data.txt
+ *               17. c_budget --format csv my_budget_data.txt
+ *               18. c_budget --all-errors my_budget_data.txt
+ *               19. c_budget --check my_budget_data.txt
+ *
+ *             If no arguments are provided, c_budget uses the file defined in
+ *             the macro DEFAULT_DATA_FILE. If the user enters a user-defined
+ *             name for the data file, c_budget will attempt to use it. A file
+ *             name of - reads the budget data from standard input, so data can
+ *             be piped straight into c_budget.
+ *
+ *             Any number of budget data files can be given, and their figures
+ *             are added up together. A directory stands for the files in it,
+ *             and a pattern such as "budget_*.txt" for the files it matches.
+ *             With -j, that many files are read at once, each by one thread.
+ *             A line that fails validation is reported with the name of its
+ *             file as well as its line number.
+ *
+ *             The -j option splits a budget data file among the given number
+ *             of threads. Only files which can be memory-mapped are split up;
+ *             anything else is read by a single thread.
+ *
+ *             There is no limit on the size of a budget data file. Normally a
+ *             file is memory-mapped, which the operating system pages in and
+ *             out as needed. The --stream option reads it in fixed-size blocks
+ *             instead, so c_budget's memory use stays the same no matter how
+ *             large the file is.
+ *
+ *             The --cache option keeps a binary copy of the transactions in
+ *             my_budget_data.txt.cbc once the file has been read without
+ *             errors. As long as the budget file doesn't change, later runs
+ *             with --cache add up the cache file instead of reading the text.
+ *
+ *             The --incremental option is for budget files that are only ever
+ *             added to at the end. The ledger is saved in
+ *             my_budget_data.txt.cbk along with how far into the file it
+ *             goes, and later runs with --incremental only read the lines
+ *             added since.
+ *
+ *             The --follow option keeps c_budget running after the budget
+ *             figures are displayed. Whenever lines are added to the end of
+ *             the file, only those lines are read and the figures are
+ *             displayed again. c_budget runs until it is interrupted.
+ *
+ *             The --categories option adds a table of the figures for each
+ *             description. With --normalize instead, descriptions that only
+ *             differ in case or spacing are counted together.
+ *
+ *             The --from and --to options add the figures between two dates,
+ *             inclusive. Each --from starts a new date range, so any number of
+ *             them can be given at once. The figures for each day are kept as
+ *             the file is read, and every range is then answered from running
+ *             totals of the days without going back over the file.
+ *
+ *             The --top option lists the given number of largest credits and
+ *             debits, with their dates and descriptions. Only that many of
+ *             each are ever kept while the file is read.
+ *
+ *             The --quantiles option adds the median, 90th percentile and
+ *             99th percentile debit for each year and month. They are
+ *             estimated from a fixed number of counts per month, to within
+ *             about 1.6% of the exact figures.
+ *
+ *             The --rolling option adds the net margins over the 30, 90 and
+ *             365 days up to the last transaction, and the worst they have
+ *             been over any 30, 90 or 365 days in a row. The data still
+ *             doesn't need to be sorted, since the figures for each day are
+ *             kept as the file is read and gone through in order afterwards.
+ *
+ *             The --bands option splits the amounts into bands at the given
+ *             amounts, and adds a table of the monthly totals of each band.
+ *
+ *             The figures are put together in memory and written out all at
+ *             once, to the screen or, with -o, to the file given.
+ *
+ *             The --format option writes the yearly, large transaction and
+ *             monthly figures for other programs to read instead of as
+ *             tables: csv, jsonl (one JSON object per line) or bin (fixed-size
+ *             records that can be used straight from memory). The layout of
+ *             each is described in export_budget_figures.c.
+ *
+ *             Normally c_budget stops at the first line that fails
+ *             validation. The --all-errors option checks the whole file (in
+ *             pieces at once with -j) and lists every bad line with its line
+ *             number, byte offset and reason. Only the first 1000 are kept,
+ *             but all of them are counted.
+ *
+ *             The --check option only validates the budget data, with the
+ *             same checks as always, and says whether it passed along with
+ *             how many lines and bytes per second were checked. Nothing is
+ *             added up or displayed.
+ *
+ *             c_budget is designed  to be C89 compliant. Therefore, it does
+ *             not utilize <stdbool.h>, variable length arrays, double forward
+ *             slashes for comments, etc.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#include <string.h>
+#include "return_codes.h"
+#include "program_init.h"
+#include "validate_budget_line.h"
+#include "budget_calculations.h"
+#include "print_budget_figures.h"
+#include "line_reader.h"
+#include "ingest_budget_data.h"
+#include "budget_cache.h"
+#include "checkpoint.h"
+#include "follow.h"
+#include "budget_files.h"
+#include "budget_memory.h"
+#include "error_list.h"
+#include "check_mode.h"
+
+int read_budget_data(const Program_options *options, Line_reader *reader,
+   Ledger *ledger, Error_list *errors, Ingest_result *result);
+int read_new_budget_data(const Program_options *options,
+   const Line_reader *reader, Ledger *ledger, Ingest_result *result);
+int read_budget_files(const Program_options *options, File_list *files,
+   Ledger *ledger, Error_list *errors, Ingest_result *result);
+
+int main(int argc, char **argv)
+{
+   Line_reader reader;
+   Program_options options;
+   Ingest_result ingest_result;
+   Ledger ledger;
+   Ledger *figures_ledger;
+   File_list files;
+   Error_list *errors = NULL;
+   double start_seconds = 0.0;
+   double check_seconds = 0.0;
+   int program_init_result = 0;
+   int open_line_reader_result = 0;
+   int ingest_result_code = 0;
+
+   /*
+    * Ensure program initialization is successful. If successful, options
+    * will hold the budget data file name and everything else the user asked
+    * for. If not, return appropriate error code.
+    */
+   program_init_result = program_init(argc, argv, &options);
+
+   if(program_init_result != 0) {
+      return program_init_result;
+   }
+
+   /*
+    * With --all-errors, every bad line is collected here instead of stopping
+    * at the first one (see error_list.c).
+    */
+   if(options.all_errors == TRUE) {
+      errors = budget_malloc(sizeof(Error_list));
+
+      if(errors == NULL) {
+         printf("\nThere was an error getting the required memory.\n");
+
+         return MEMORY_ERROR;
+      }
+
+      init_error_list(errors);
+   }
+
+   /*
+    * With --check, the lines are only validated, so there is no ledger to add
+    * them to.
+    */
+   init_ledger(&ledger, &options.ledger_options);
+   init_file_list(&files);
+   figures_ledger = options.check_only == TRUE ? NULL : &ledger;
+   start_seconds = get_check_seconds();
+
+   if(options.multiple_files == TRUE) {
+      ingest_result_code = read_budget_files(&options, &files, figures_ledger,
+         errors, &ingest_result);
+   }
+   else {
+      open_line_reader_result = open_line_reader(&reader,
+         options.data_file_name, options.allow_mapping);
+
+      if(open_line_reader_result == MEMORY_ERROR) {
+         printf("\nThere was an error getting the required memory.\n");
+
+         budget_free(errors);
+
+         return MEMORY_ERROR;
+      }
+
+      if(open_line_reader_result != 0) {
+         printf("\nFile could not be opened. Please ensure %s ",
+            options.data_file_name);
+         printf("exists, and try again.\n");
+
+         budget_free(errors);
+
+         return FILE_ERROR;
+      }
+
+      ingest_result_code = read_budget_data(&options, &reader,
+         figures_ledger, errors, &ingest_result);
+
+      close_line_reader(&reader);
+   }
+
+   check_seconds = get_check_seconds() - start_seconds;
+
+   if(ingest_result_code == 0 && errors != NULL && errors->total > 0) {
+      ingest_result_code = DATA_VALIDATION_ERROR;
+   }
+
+   if(ingest_result_code != 0) {
+      free_ledger(&ledger);
+   }
+
+   /*
+    * The name of the file an error is in belongs to files, so files is only
+    * freed once the error has been printed.
+    */
+   switch(ingest_result_code) {
+      case 0:
+      case ARGUMENT_ERROR:
+         break;
+
+      case DATA_VALIDATION_ERROR:
+         if(errors != NULL) {
+            print_error_list(errors);
+         }
+         else {
+            print_validation_error(ingest_result.validation_error,
+               ingest_result.file_name, ingest_result.line_count);
+         }
+         break;
+
+      case MEMORY_ERROR:
+         printf("\nThere was an error getting the required memory.\n");
+         break;
+
+      default:
+         printf("\nThere was an error reading %s.\n",
+            ingest_result.file_name != NULL ? ingest_result.file_name
+            : options.data_file_name);
+         ingest_result_code = FILE_ERROR;
+         break;
+   }
+
+   /*
+    * Reading stops at the first bad line unless --all-errors was given, and
+    * that line was checked too, though it isn't in line_count.
+    */
+   if(options.check_only == TRUE && (ingest_result_code == 0
+      || ingest_result_code == DATA_VALIDATION_ERROR)) {
+
+      print_check_summary(ingest_result_code == 0 ? TRUE : FALSE,
+         ingest_result.line_count
+         + (ingest_result.validation_error != 0 ? 1 : 0),
+         ingest_result.byte_count, check_seconds);
+   }
+
+   budget_free(errors);
+   free_file_list(&files);
+
+   if(ingest_result_code != 0) {
+      return ingest_result_code;
+   }
+
+   if(options.check_only == TRUE) {
+      free_ledger(&ledger);
+
+      return 0;
+   }
+
+   if(display_budget_figures(&ledger, &options) != 0) {
+      printf("\nThe budget figures could not be written to %s.\n",
+         options.output_file_name != NULL ? options.output_file_name
+         : "standard output");
+
+      free_ledger(&ledger);
+
+      return FILE_ERROR;
+   }
+
+   free_ledger(&ledger);
+
+   return 0;
+}
+
+/*
+ * Get each line from budget data file. Perform validation checks and
+ * calculations. A file that is mapped into memory can be split up among
+ * several threads. Anything else is read from front to back.
+ *
+ * With --cache, an up to date cache file is used instead of the budget file.
+ * If there isn't one, the budget file is read by a single thread and the
+ * cache file is written afterwards.
+ *
+ * Return 0 if successful. Return applicable error code, otherwise (see
+ * return_codes.h).
+ */
+int read_budget_data(const Program_options *options, Line_reader *reader,
+   Ledger *ledger, Error_list *errors, Ingest_result *result) {
+
+   Cache_writer cache_writer;
+   Bool cache_loaded = FALSE;
+   int load_cache_result = 0;
+   int ingest_result_code = 0;
+
+   result->validation_error = 0;
+   result->line_count = 0;
+   result->byte_count = 0;
+   result->file_name = NULL;
+
+   if(options->follow == TRUE) {
+      return follow_budget_file(reader, options, ledger, result);
+   }
+
+   if(options->use_cache == TRUE
+      && strcmp(options->data_file_name, STANDARD_INPUT_FILE_NAME) != 0) {
+
+      load_cache_result = load_cache(options->data_file_name, ledger,
+         &cache_loaded);
+
+      if(load_cache_result != 0 || cache_loaded == TRUE) {
+         return load_cache_result;
+      }
+
+      if(open_cache_writer(&cache_writer, options->data_file_name) == 0) {
+         ingest_result_code = ingest_budget_lines(reader, ledger,
+            &cache_writer, NULL, result);
+
+         if(ingest_result_code != 0) {
+            (void) close_cache_writer(&cache_writer, FALSE);
+         }
+         else if(close_cache_writer(&cache_writer, TRUE) != 0) {
+            printf("\nThe cache file for %s could not be written.\n",
+               options->data_file_name);
+         }
+
+         return ingest_result_code;
+      }
+   }
+
+   if(options->incremental == TRUE && reader->type == MAPPED_READER
+      && reader->map.length > 0) {
+
+      return read_new_budget_data(options, reader, ledger, result);
+   }
+
+   if(options->thread_count > 1 && reader->type == MAPPED_READER) {
+      return ingest_budget_data_in_parallel(reader->map.data,
+         reader->map.length, options->thread_count, ledger, errors, result);
+   }
+
+   return ingest_budget_lines(reader, ledger, NULL, errors, result);
+}
+
+/*
+ * Pick up from the budget file's checkpoint, if it has one that still
+ * matches, and read only the lines after it. A new checkpoint is saved at the
+ * end of the last complete line. A last line without a new line character
+ * may still be being written, so it is added up but left out of the
+ * checkpoint.
+ *
+ * Return 0 if successful. Return applicable error code, otherwise (see
+ * return_codes.h).
+ */
+int read_new_budget_data(const Program_options *options,
+   const Line_reader *reader, Ledger *ledger, Ingest_result *result) {
+
+   Line_reader new_data_reader;
+   Ingest_result last_line_result;
+   Bool checkpoint_loaded = FALSE;
+   Uint64 offset = 0;
+   Uint64 line_count = 0;
+   const char *new_data;
+   size_t new_data_length;
+   size_t complete_length;
+   int return_code = 0;
+
+   return_code = load_checkpoint(options->data_file_name, &reader->map,
+      ledger, &offset, &line_count, &checkpoint_loaded);
+
+   if(return_code != 0) {
+      return return_code;
+   }
+
+   new_data = reader->map.data + offset;
+   new_data_length = reader->map.length - (size_t) offset;
+   complete_length = new_data_length;
+
+   while(complete_length > 0 && new_data[complete_length - 1] != '\n') {
+      complete_length--;
+   }
+
+   if(options->thread_count > 1) {
+      return_code = ingest_budget_data_in_parallel(new_data, complete_length,
+         options->thread_count, ledger, NULL, result);
+   }
+   else {
+      open_memory_line_reader(&new_data_reader, new_data, complete_length);
+      return_code = ingest_budget_lines(&new_data_reader, ledger, NULL,
+         NULL, result);
+      close_line_reader(&new_data_reader);
+   }
+
+   result->line_count += line_count;
+   result->byte_count += offset;
+
+   if(return_code != 0) {
+      return return_code;
+   }
+
+   if(complete_length > 0 || checkpoint_loaded == FALSE) {
+      if(save_checkpoint(options->data_file_name, &reader->map, ledger,
+         offset + complete_length, result->line_count) != 0) {
+
+         printf("\nThe checkpoint file for %s could not be written.\n",
+            options->data_file_name);
+      }
+   }
+
+   if(complete_length < new_data_length) {
+      open_memory_line_reader(&new_data_reader, new_data + complete_length,
+         new_data_length - complete_length);
+      return_code = ingest_budget_lines(&new_data_reader, ledger, NULL,
+         NULL, &last_line_result);
+      close_line_reader(&new_data_reader);
+
+      result->validation_error = last_line_result.validation_error;
+      result->line_count += last_line_result.line_count;
+      result->byte_count += last_line_result.byte_count;
+   }
+
+   return return_code;
+}
+
+/*
+ * Find every budget file the user asked for and read them all, several at a
+ * time with -j (see budget_files.c). The names found are kept in files.
+ *
+ * Return 0 if successful. Return applicable error code, otherwise (see
+ * return_codes.h).
+ */
+int read_budget_files(const Program_options *options, File_list *files,
+   Ledger *ledger, Error_list *errors, Ingest_result *result) {
+
+   int i;
+   int add_budget_files_result = 0;
+
+   result->validation_error = 0;
+   result->line_count = 0;
+   result->byte_count = 0;
+   result->file_name = NULL;
+
+   for(i = 0; i < options->data_file_count; i++) {
+      add_budget_files_result = add_budget_files(files,
+         options->data_file_arguments[i]);
+
+      if(add_budget_files_result == FILE_ERROR) {
+         printf("\nNo budget data files were found for %s.\n",
+            options->data_file_arguments[i]);
+
+         return ARGUMENT_ERROR;
+      }
+
+      if(add_budget_files_result != 0) {
+         return add_budget_files_result;
+      }
+   }
+
+   return ingest_budget_files(files, options->thread_count,
+      options->allow_mapping, ledger, errors, result);
+}
@@ -0,0 +1,265 @@
+/*
+ * Name:       categories.c
+ *
+ * Purpose:    Functions for adding up transactions by description.
+ *
+ *             Descriptions are used exactly as they are, or normalized first
+ *             so that "Groceries", "groceries" and " GROCERIES " all count as
+ *             the same category: letters are made lowercase, spaces and tabs
+ *             are trimmed from both ends, and any run of them inside is made
+ *             a single space.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#include "size_limits.h"
+#include "return_codes.h"
+#include "budget_memory.h"
+#include "categories.h"
+
+#define INITIAL_FIGURE_CAPACITY 512
+
+size_t normalize_description(const char *description,
+   size_t description_length, char *key);
+Category_figures *get_category_figures(Category_table *table,
+   const char *name, size_t name_length);
+
+void init_category_table(Category_table *table) {
+
+   init_string_table(&table->names);
+   table->figures = NULL;
+   table->figure_capacity = 0;
+   table->growth_count = 0;
+}
+
+void free_category_table(Category_table *table) {
+
+   free_string_table(&table->names);
+   budget_free(table->figures);
+
+   init_category_table(table);
+}
+
+/*
+ * Add amount to the description's category.
+ *
+ * Return 0 if successful. Return MEMORY_ERROR if the table could not be
+ * grown.
+ */
+int add_to_category(Category_table *table, const char *description,
+   size_t description_length, Bool normalize, Cents amount) {
+
+   char key[LINE_BUFFER_SIZE];
+   Category_figures *figures;
+
+   /*
+    * A description is always shorter than a line, so it fits in key.
+    */
+   if(normalize == TRUE) {
+      description_length = normalize_description(description,
+         description_length, key);
+      description = key;
+   }
+
+   figures = get_category_figures(table, description, description_length);
+
+   if(figures == NULL) {
+      return MEMORY_ERROR;
+   }
+
+   if(amount > 0) {
+      figures->credits += amount;
+   }
+   else {
+      figures->debits += amount;
+   }
+
+   figures->transaction_count++;
+
+   return 0;
+}
+
+/*
+ * Add table into total. Categories new to total are added in the order table
+ * first saw them.
+ *
+ * Return 0 if successful. Return MEMORY_ERROR if total could not be grown.
+ */
+int merge_category_table(Category_table *total, const Category_table *table) {
+
+   size_t i;
+   const char *name;
+   size_t name_length;
+   Category_figures *figures;
+
+   for(i = 0; i < table->names.entry_count; i++) {
+      name = get_string(&table->names, (Uint32) i, &name_length);
+      figures = get_category_figures(total, name, name_length);
+
+      if(figures == NULL) {
+         return MEMORY_ERROR;
+      }
+
+      figures->credits += table->figures[i].credits;
+      figures->debits += table->figures[i].debits;
+      figures->transaction_count += table->figures[i].transaction_count;
+   }
+
+   return 0;
+}
+
+/*
+ * Number of allocations made so far by the table.
+ */
+unsigned long get_category_growth_count(const Category_table *table) {
+
+   return table->growth_count + table->names.growth_count;
+}
+
+/*
+ * Write every category's name and figures to fp. Return FALSE if they could
+ * not all be written.
+ */
+Bool write_category_table(const Category_table *table, FILE *fp) {
+
+   Uint64 count = table->names.entry_count;
+   Uint64 name_length;
+   const char *name;
+   size_t length;
+   size_t i;
+
+   if(fwrite(&count, sizeof(Uint64), 1, fp) != 1) {
+      return FALSE;
+   }
+
+   for(i = 0; i < table->names.entry_count; i++) {
+      name = get_string(&table->names, (Uint32) i, &length);
+      name_length = length;
+
+      if(fwrite(&name_length, sizeof(Uint64), 1, fp) != 1
+         || fwrite(name, 1, length, fp) != length
+         || fwrite(&table->figures[i], sizeof(Category_figures), 1, fp)
+            != 1) {
+
+         return FALSE;
+      }
+   }
+
+   return TRUE;
+}
+
+/*
+ * Read categories written by write_category_table into table, which must be
+ * empty.
+ *
+ * Return 0 if successful. Return FILE_ERROR if fp doesn't hold categories,
+ * or MEMORY_ERROR if the table could not be grown.
+ */
+int read_category_table(FILE *fp, Category_table *table) {
+
+   char name[LINE_BUFFER_SIZE];
+   Uint64 count;
+   Uint64 name_length;
+   Uint64 i;
+   Category_figures *figures;
+
+   if(fread(&count, sizeof(Uint64), 1, fp) != 1) {
+      return FILE_ERROR;
+   }
+
+   for(i = 0; i < count; i++) {
+      if(fread(&name_length, sizeof(Uint64), 1, fp) != 1
+         || name_length >= LINE_BUFFER_SIZE
+         || fread(name, 1, (size_t) name_length, fp) != name_length) {
+
+         return FILE_ERROR;
+      }
+
+      figures = get_category_figures(table, name, (size_t) name_length);
+
+      if(figures == NULL) {
+         return MEMORY_ERROR;
+      }
+
+      if(fread(figures, sizeof(Category_figures), 1, fp) != 1) {
+         return FILE_ERROR;
+      }
+   }
+
+   return 0;
+}
+
+/*
+ * Write the normalized form of description into key and return its length,
+ * which is never more than description_length.
+ */
+size_t normalize_description(const char *description,
+   size_t description_length, char *key) {
+
+   size_t i;
+   size_t key_length = 0;
+   Bool space_pending = FALSE;
+   char c;
+
+   for(i = 0; i < description_length; i++) {
+      c = description[i];
+
+      if(c == ' ' || c == '\t') {
+         space_pending = key_length > 0 ? TRUE : FALSE;
+         continue;
+      }
+
+      if(space_pending == TRUE) {
+         key[key_length++] = ' ';
+         space_pending = FALSE;
+      }
+
+      if(c >= 'A' && c <= 'Z') {
+         c = (char) (c - 'A' + 'a');
+      }
+
+      key[key_length++] = c;
+   }
+
+   return key_length;
+}
+
+/*
+ * Return the figures for the named category, adding the category if it is
+ * new. Return NULL if the table could not be grown.
+ */
+Category_figures *get_category_figures(Category_table *table,
+   const char *name, size_t name_length) {
+
+   size_t category_count = table->names.entry_count;
+   Uint32 id;
+   Category_figures *figures;
+
+   if(intern_string(&table->names, name, name_length, &id) != 0) {
+      return NULL;
+   }
+
+   if(id == category_count) {
+      figures = grow_array(table->figures, sizeof(Category_figures),
+         category_count, &table->figure_capacity, category_count + 1,
+         INITIAL_FIGURE_CAPACITY, &table->growth_count);
+
+      if(figures == NULL) {
+         return NULL;
+      }
+
+      table->figures = figures;
+      table->figures[id].credits = 0;
+      table->figures[id].debits = 0;
+      table->figures[id].transaction_count = 0;
+   }
+
+   return &table->figures[id];
+}
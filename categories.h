@@ -0,0 +1,57 @@
+/*
+ * Name:       categories.h
+ *
+ * Purpose:    Typedefs and function definitions for categories.c.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#ifndef CATEGORIES_H
+
+#define CATEGORIES_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include "boolean.h"
+#include "integer_types.h"
+#include "cents.h"
+#include "string_table.h"
+
+/*
+ * Everything added up for one category.
+ */
+typedef struct {
+   Cents credits;
+   Cents debits;
+   Uint64 transaction_count;
+} Category_figures;
+
+/*
+ * A category is a description (or a normalized description, see
+ * categories.c). Each category's name is kept once in names, and its figures
+ * are at the same index as its id.
+ */
+typedef struct {
+   String_table names;
+   Category_figures *figures;
+   size_t figure_capacity;
+   unsigned long growth_count;
+} Category_table;
+
+void init_category_table(Category_table *table);
+void free_category_table(Category_table *table);
+int add_to_category(Category_table *table, const char *description,
+   size_t description_length, Bool normalize, Cents amount);
+int merge_category_table(Category_table *total, const Category_table *table);
+unsigned long get_category_growth_count(const Category_table *table);
+Bool write_category_table(const Category_table *table, FILE *fp);
+int read_category_table(FILE *fp, Category_table *table);
+
+#endif
@@ -0,0 +1,72 @@
+/*
+ * Name:       cents.c
+ *
+ * Purpose:    Functions for working with amounts of money stored as a whole
+ *             number of cents.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#include "cents.h"
+
+/*
+ * Write amount into cents_string in the form -1234.56. cents_string must have
+ * room for CENTS_STRING_LENGTH characters.
+ */
+void format_cents(Cents amount, char *cents_string) {
+
+   char digits[CENTS_STRING_LENGTH];
+   int digit_count = 0;
+   Uint64 magnitude;
+
+   /*
+    * Work with the magnitude as an unsigned number so that the most negative
+    * amount doesn't overflow when its sign is flipped.
+    */
+   if(amount < 0) {
+      magnitude = (Uint64) 0 - (Uint64) amount;
+      *cents_string++ = '-';
+   }
+   else {
+      magnitude = (Uint64) amount;
+   }
+
+   /*
+    * Digits come out backwards, starting with the cents. Always produce at
+    * least one digit before the decimal point (0.05, not .05).
+    */
+   while(magnitude > 0 || digit_count < 3) {
+      digits[digit_count++] = (char) ('0' + magnitude % 10);
+      magnitude /= 10;
+   }
+
+   while(digit_count > 0) {
+      *cents_string++ = digits[--digit_count];
+
+      if(digit_count == 2) {
+         *cents_string++ = '.';
+      }
+   }
+
+   *cents_string = '\0';
+}
+
+/*
+ * Divide amount by divisor, rounding to the nearest cent (halves are rounded
+ * away from zero).
+ */
+Cents divide_cents(Cents amount, int divisor) {
+
+   if(amount < 0) {
+      return -((-amount * 2 + divisor) / (divisor * 2));
+   }
+
+   return (amount * 2 + divisor) / (divisor * 2);
+}
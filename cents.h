@@ -0,0 +1,39 @@
+/*
+ * Name:       cents.h
+ *
+ * Purpose:    Typedef, macros and function definitions for cents.c.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#ifndef CENTS_H
+
+#define CENTS_H
+
+#include "integer_types.h"
+
+/*
+ * Amounts of money are whole numbers of cents, so adding them up is exact no
+ * matter how many there are or what order they are added in.
+ */
+typedef Int64 Cents;
+
+#define CENTS_PER_DOLLAR 100
+
+/*
+ * Long enough for any Cents value as a string, such as
+ * -92233720368547758.08, plus the null character.
+ */
+#define CENTS_STRING_LENGTH 24
+
+void format_cents(Cents amount, char *cents_string);
+Cents divide_cents(Cents amount, int divisor);
+
+#endif
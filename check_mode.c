@@ -0,0 +1,80 @@
+/*
+ * Name:       check_mode.c
+ *
+ * Purpose:    Time a --check run and report how fast the lines were checked.
+ *
+ *             --check reads the budget data through the same
+ *             parse_budget_line as every other run, so a file passes the
+ *             check exactly when it could be added up. Only the figures are
+ *             left out.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <time.h>
+#include "platform.h"
+#include "counts.h"
+#include "check_mode.h"
+
+/*
+ * Return a time in seconds, for measuring how long something takes. On POSIX
+ * platforms this is wall clock time that never jumps. Elsewhere, it is the
+ * processor time used by c_budget.
+ */
+double get_check_seconds(void) {
+
+#ifdef POSIX_PLATFORM
+   struct timespec now;
+
+   if(clock_gettime(CLOCK_MONOTONIC, &now) != 0) {
+      return 0.0;
+   }
+
+   return (double) now.tv_sec + (double) now.tv_nsec / 1e9;
+#else
+   return (double) clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+/*
+ * Print whether the check passed, how much was checked and how fast.
+ */
+void print_check_summary(Bool passed, Uint64 line_count, Uint64 byte_count,
+   double seconds) {
+
+   char line_count_string[COUNT_STRING_LENGTH];
+   char byte_count_string[COUNT_STRING_LENGTH];
+   char lines_per_second_string[COUNT_STRING_LENGTH];
+   char bytes_per_second_string[COUNT_STRING_LENGTH];
+
+   /*
+    * A run too quick to measure is counted as taking a microsecond.
+    */
+   if(seconds < 1e-6) {
+      seconds = 1e-6;
+   }
+
+   format_count(line_count, line_count_string);
+   format_count(byte_count, byte_count_string);
+   format_count((Uint64) ((double) line_count / seconds),
+      lines_per_second_string);
+   format_count((Uint64) ((double) byte_count / seconds),
+      bytes_per_second_string);
+
+   printf("\n%s: %s %s, %s %s checked in %.3f seconds\n",
+      passed == TRUE ? "OK" : "FAILED", line_count_string,
+      line_count == 1 ? "line" : "lines", byte_count_string,
+      byte_count == 1 ? "byte" : "bytes", seconds);
+   printf("   %s lines/sec, %s bytes/sec\n\n", lines_per_second_string,
+      bytes_per_second_string);
+}
@@ -0,0 +1,27 @@
+/*
+ * Name:       check_mode.h
+ *
+ * Purpose:    Function definitions for check_mode.c.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#ifndef CHECK_MODE_H
+
+#define CHECK_MODE_H
+
+#include "boolean.h"
+#include "integer_types.h"
+
+double get_check_seconds(void);
+void print_check_summary(Bool passed, Uint64 line_count, Uint64 byte_count,
+   double seconds);
+
+#endif
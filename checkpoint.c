@@ -0,0 +1,170 @@
+/*
+ * Name:       checkpoint.c
+ *
+ * Purpose:    Save how far into a budget data file c_budget has read, along
+ *             with the ledger up to that point, so that the next run only has
+ *             to read what has been added to the end of the file since.
+ *
+ *             A checkpoint is only used if the budget file is at least as long
+ *             as the checkpoint's offset and every byte of the file before
+ *             the offset still hashes the same (see hash_all in hash.c). If
+ *             the budget file was edited anywhere other than at the end, the
+ *             checkpoint is ignored and the whole file is read again.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "return_codes.h"
+#include "hash.h"
+#include "checkpoint.h"
+
+#define CHECKPOINT_MAGIC "c_budchk"
+#define CHECKPOINT_VERSION 7
+#define CHECKPOINT_BYTE_ORDER 0x01020304UL
+
+void make_checkpoint_file_name(const char *data_file_name,
+   const char *extension, char *checkpoint_file_name);
+
+/*
+ * If data_file_name has a checkpoint that still matches data (the mapped
+ * budget file), read its ledger into ledger, which must be empty, set offset
+ * and line_count to where the checkpoint left off and set loaded to TRUE.
+ * Otherwise leave ledger empty, set offset and line_count to 0 and set
+ * loaded to FALSE.
+ *
+ * Return 0 if successful. Return MEMORY_ERROR if the ledger could not be
+ * grown.
+ */
+int load_checkpoint(const char *data_file_name, const File_map *data,
+   Ledger *ledger, Uint64 *offset, Uint64 *line_count, Bool *loaded) {
+
+   char checkpoint_file_name[CHECKPOINT_FILE_NAME_LENGTH + 1];
+   Checkpoint_header header;
+   FILE *fp;
+   int read_ledger_result = 0;
+
+   *offset = 0;
+   *line_count = 0;
+   *loaded = FALSE;
+
+   make_checkpoint_file_name(data_file_name, CHECKPOINT_FILE_EXTENSION,
+      checkpoint_file_name);
+
+   fp = fopen(checkpoint_file_name, "rb");
+
+   if(fp == NULL) {
+      return 0;
+   }
+
+   if(fread(&header, sizeof(Checkpoint_header), 1, fp) != 1
+      || memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic)) != 0
+      || header.version != CHECKPOINT_VERSION
+      || header.byte_order != CHECKPOINT_BYTE_ORDER
+      || header.offset > data->length
+      || hash_all(data->data, (size_t) header.offset)
+         != header.prefix_hash) {
+
+      (void) fclose(fp);
+
+      return 0;
+   }
+
+   read_ledger_result = read_ledger(fp, ledger);
+
+   (void) fclose(fp);
+
+   if(read_ledger_result != 0) {
+      free_ledger(ledger);
+
+      return read_ledger_result == MEMORY_ERROR ? MEMORY_ERROR : 0;
+   }
+
+   *offset = header.offset;
+   *line_count = header.line_count;
+   *loaded = TRUE;
+
+   return 0;
+}
+
+/*
+ * Save ledger as the state of data_file_name up to offset. The checkpoint is
+ * written under a temporary name and then renamed, so a checkpoint file is
+ * never left half written.
+ *
+ * Return 0 if successful. Return FILE_ERROR, otherwise.
+ */
+int save_checkpoint(const char *data_file_name, const File_map *data,
+   const Ledger *ledger, Uint64 offset, Uint64 line_count) {
+
+   char checkpoint_file_name[CHECKPOINT_FILE_NAME_LENGTH + 1];
+   char temporary_file_name[CHECKPOINT_FILE_NAME_LENGTH + 1];
+   Checkpoint_header header;
+   FILE *fp;
+   int return_code = 0;
+
+   make_checkpoint_file_name(data_file_name, CHECKPOINT_FILE_EXTENSION,
+      checkpoint_file_name);
+   make_checkpoint_file_name(data_file_name, CHECKPOINT_FILE_EXTENSION ".tmp",
+      temporary_file_name);
+
+   (void) memset(&header, 0, sizeof(Checkpoint_header));
+   (void) memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+   header.version = CHECKPOINT_VERSION;
+   header.byte_order = CHECKPOINT_BYTE_ORDER;
+   header.offset = offset;
+   header.prefix_hash = hash_all(data->data, (size_t) offset);
+   header.line_count = line_count;
+
+   fp = fopen(temporary_file_name, "wb");
+
+   if(fp == NULL) {
+      return FILE_ERROR;
+   }
+
+   if(fwrite(&header, sizeof(Checkpoint_header), 1, fp) != 1
+      || write_ledger(ledger, fp) == FALSE) {
+
+      return_code = FILE_ERROR;
+   }
+
+   if(fclose(fp) != 0) {
+      return_code = FILE_ERROR;
+   }
+
+   /*
+    * rename does not replace an existing file on every platform.
+    */
+   if(return_code == 0) {
+      (void) remove(checkpoint_file_name);
+
+      if(rename(temporary_file_name, checkpoint_file_name) != 0) {
+         return_code = FILE_ERROR;
+      }
+   }
+
+   if(return_code != 0) {
+      (void) remove(temporary_file_name);
+   }
+
+   return return_code;
+}
+
+/*
+ * data_file_name is at most FILE_NAME_LENGTH characters (see program_init.c)
+ * and extension at most 8, so checkpoint_file_name always has room for both.
+ */
+void make_checkpoint_file_name(const char *data_file_name,
+   const char *extension, char *checkpoint_file_name) {
+
+   (void) strcpy(checkpoint_file_name, data_file_name);
+   (void) strcat(checkpoint_file_name, extension);
+}
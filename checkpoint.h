@@ -0,0 +1,57 @@
+/*
+ * Name:       checkpoint.h
+ *
+ * Purpose:    Typedefs, macros and function definitions for checkpoint.c.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#ifndef CHECKPOINT_H
+
+#define CHECKPOINT_H
+
+#include "boolean.h"
+#include "integer_types.h"
+#include "program_init.h"
+#include "file_map.h"
+#include "ledger.h"
+
+/*
+ * The checkpoint file for a budget data file has the same name with this
+ * added to the end.
+ */
+#define CHECKPOINT_FILE_EXTENSION ".cbk"
+#define CHECKPOINT_FILE_NAME_LENGTH (FILE_NAME_LENGTH + 8)
+
+/*
+ * The start of a checkpoint file. It is followed by the ledger (see
+ * write_ledger in ledger.c). Everything is in the byte order of the computer
+ * that wrote it.
+ *
+ * offset is how far into the budget file the ledger goes, which is always
+ * just past a new line character. prefix_hash is hash_all (see hash.c) of
+ * the budget file up to offset, and line_count is the number of lines up to
+ * offset.
+ */
+typedef struct {
+   char magic[8];
+   Uint32 version;
+   Uint32 byte_order;
+   Uint64 offset;
+   Uint64 prefix_hash;
+   Uint64 line_count;
+} Checkpoint_header;
+
+int load_checkpoint(const char *data_file_name, const File_map *data,
+   Ledger *ledger, Uint64 *offset, Uint64 *line_count, Bool *loaded);
+int save_checkpoint(const char *data_file_name, const File_map *data,
+   const Ledger *ledger, Uint64 offset, Uint64 line_count);
+
+#endif
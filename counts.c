@@ -0,0 +1,43 @@
+/*
+ * Name:       counts.c
+ *
+ * Purpose:    Functions for working with 64-bit counts of lines and bytes.
+ *
+ *             C89's printf has no conversion for a 64-bit integer, so counts
+ *             are turned into strings here and printed with %s.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#include "counts.h"
+
+/*
+ * Write count into count_string in decimal. count_string must have room for
+ * COUNT_STRING_LENGTH characters.
+ */
+void format_count(Uint64 count, char *count_string) {
+
+   char digits[COUNT_STRING_LENGTH];
+   int digit_count = 0;
+
+   /*
+    * Digits come out backwards, starting with the ones.
+    */
+   do {
+      digits[digit_count++] = (char) ('0' + count % 10);
+      count /= 10;
+   } while(count > 0);
+
+   while(digit_count > 0) {
+      *count_string++ = digits[--digit_count];
+   }
+
+   *count_string = '\0';
+}
@@ -0,0 +1,30 @@
+/*
+ * Name:       counts.h
+ *
+ * Purpose:    Macros and function definitions for counts.c.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#ifndef COUNTS_H
+
+#define COUNTS_H
+
+#include "integer_types.h"
+
+/*
+ * Long enough for any Uint64 as a string, such as 18446744073709551615, plus
+ * the null character.
+ */
+#define COUNT_STRING_LENGTH 21
+
+void format_count(Uint64 count, char *count_string);
+
+#endif
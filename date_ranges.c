@@ -0,0 +1,134 @@
+/*
+ * Name:       date_ranges.c
+ *
+ * Purpose:    Functions for adding up the figures between any two dates.
+ *
+ *             A ledger that keeps days has the figures for every day. Once
+ *             the budget file has been read, the days are turned into
+ *             running totals, and the figures for a range are the difference
+ *             between the running totals at its two ends. However many
+ *             ranges are asked for, the days are only gone through once.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#include <stdio.h>
+#include "budget_memory.h"
+#include "date_ranges.h"
+
+void init_date_range(Date_range *range) {
+
+   range->has_first_day = FALSE;
+   range->first_day = 0;
+   range->has_last_day = FALSE;
+   range->last_day = LAST_DAY_NUMBER;
+}
+
+/*
+ * Fill in totals for the used months of ledger, which must keep days.
+ */
+void build_range_totals(const Ledger *ledger, Range_totals *totals) {
+
+   int i;
+   const Day_figures *days;
+
+   totals->ledger = ledger;
+   totals->sums = NULL;
+   totals->first_day = 0;
+   totals->day_count = 0;
+
+   if(ledger->used == FALSE) {
+      return;
+   }
+
+   totals->first_day = DAYS_PER_MONTH * ledger->first_used_month;
+   totals->day_count = DAYS_PER_MONTH
+      * (ledger->last_used_month - ledger->first_used_month + 1);
+   totals->sums = budget_malloc((totals->day_count + 1)
+      * sizeof(Day_figures));
+
+   if(totals->sums == NULL) {
+      return;
+   }
+
+   days = get_day_figures(ledger, totals->first_day);
+
+   totals->sums[0].credits = 0;
+   totals->sums[0].debits = 0;
+
+   for(i = 0; i < totals->day_count; i++) {
+      totals->sums[i + 1].credits = totals->sums[i].credits + days[i].credits;
+      totals->sums[i + 1].debits = totals->sums[i].debits + days[i].debits;
+   }
+}
+
+void free_range_totals(Range_totals *totals) {
+
+   budget_free(totals->sums);
+
+   totals->sums = NULL;
+   totals->day_count = 0;
+}
+
+/*
+ * Add up the figures for range. Only the part of range inside the used
+ * months can have anything in it.
+ */
+void get_range_figures(const Range_totals *totals, const Date_range *range,
+   Day_figures *figures) {
+
+   int first = range->first_day - totals->first_day;
+   int last = range->last_day - totals->first_day;
+   int i;
+   const Day_figures *days;
+
+   figures->credits = 0;
+   figures->debits = 0;
+
+   if(first < 0) {
+      first = 0;
+   }
+
+   if(last >= totals->day_count) {
+      last = totals->day_count - 1;
+   }
+
+   if(first > last) {
+      return;
+   }
+
+   if(totals->sums != NULL) {
+      figures->credits = totals->sums[last + 1].credits
+         - totals->sums[first].credits;
+      figures->debits = totals->sums[last + 1].debits
+         - totals->sums[first].debits;
+
+      return;
+   }
+
+   days = get_day_figures(totals->ledger, totals->first_day);
+
+   for(i = first; i <= last; i++) {
+      figures->credits += days[i].credits;
+      figures->debits += days[i].debits;
+   }
+}
+
+/*
+ * Write the date of day_number into s as mm/dd/yyyy. s must have room for
+ * DATE_STRING_LENGTH characters.
+ */
+void format_day_number(int day_number, char *s) {
+
+   int month_number = day_number / DAYS_PER_MONTH;
+
+   (void) sprintf(s, "%02d/%02d/%04d", month_number % 12 + 1,
+      day_number % DAYS_PER_MONTH + 1, month_number / 12);
+}
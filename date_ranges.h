@@ -0,0 +1,68 @@
+/*
+ * Name:       date_ranges.h
+ *
+ * Purpose:    Typedefs, macros and function definitions for date_ranges.c.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#ifndef DATE_RANGES_H
+
+#define DATE_RANGES_H
+
+#include "boolean.h"
+#include "ledger.h"
+
+/*
+ * Most date ranges that can be given on the command line.
+ */
+#define MAX_DATE_RANGES 1000
+
+/*
+ * Length of a date printed by format_day_number, including the null
+ * character.
+ */
+#define DATE_STRING_LENGTH 11
+
+/*
+ * The days from first_day to last_day, inclusive (see DAY_NUMBER in
+ * ledger.h). A range without a first or last day starts at the earliest day
+ * or ends at the latest day there can be.
+ */
+typedef struct {
+   Bool has_first_day;
+   int first_day;
+   Bool has_last_day;
+   int last_day;
+} Date_range;
+
+/*
+ * Running totals of the days in a ledger, so the figures for any range of
+ * days take two lookups. sums[i] holds everything before day first_day + i,
+ * for i from 0 to day_count.
+ *
+ * If there wasn't enough memory for sums, it is NULL and the days in each
+ * range are added up from the ledger instead.
+ */
+typedef struct {
+   const Ledger *ledger;
+   Day_figures *sums;
+   int first_day;
+   int day_count;
+} Range_totals;
+
+void init_date_range(Date_range *range);
+void build_range_totals(const Ledger *ledger, Range_totals *totals);
+void free_range_totals(Range_totals *totals);
+void get_range_figures(const Range_totals *totals, const Date_range *range,
+   Day_figures *figures);
+void format_day_number(int day_number, char *s);
+
+#endif
@@ -0,0 +1,114 @@
+/*
+ * Name:       error_list.c
+ *
+ * Purpose:    Keep a list of the lines that failed validation, for reading a
+ *             whole budget data file even when some of its lines are bad.
+ *
+ *             The list has a fixed size, so a file full of bad lines can't
+ *             use up memory. Lists from pieces of a file, or from several
+ *             files, are merged in file order, so the lines kept are always
+ *             the first ones.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#include <stdio.h>
+#include "counts.h"
+#include "validate_budget_line.h"
+#include "error_list.h"
+
+void init_error_list(Error_list *list) {
+
+   list->count = 0;
+   list->total = 0;
+}
+
+void add_validation_failure(Error_list *list, Uint64 line_number,
+   Uint64 byte_offset, int reason) {
+
+   Validation_failure *failure;
+
+   if(list->count < MAX_LISTED_ERRORS) {
+      failure = &list->failures[list->count++];
+      failure->file_name = NULL;
+      failure->line_number = line_number;
+      failure->byte_offset = byte_offset;
+      failure->reason = reason;
+   }
+
+   list->total++;
+}
+
+/*
+ * Add the bad lines in list to the end of total. list is for a piece of a
+ * file starting line_offset lines and byte_offset bytes into it, or for the
+ * whole of the file file_name.
+ */
+void merge_error_list(Error_list *total, const Error_list *list,
+   const char *file_name, Uint64 line_offset, Uint64 byte_offset) {
+
+   const Validation_failure *failure;
+   int i;
+
+   for(i = 0; i < list->count && total->count < MAX_LISTED_ERRORS; i++) {
+      failure = &list->failures[i];
+
+      total->failures[total->count].file_name = file_name != NULL
+         ? file_name : failure->file_name;
+      total->failures[total->count].line_number = failure->line_number
+         + line_offset;
+      total->failures[total->count].byte_offset = failure->byte_offset
+         + byte_offset;
+      total->failures[total->count].reason = failure->reason;
+      total->count++;
+   }
+
+   total->total += list->total;
+}
+
+/*
+ * Print one line for each bad line kept, then how many there are in all.
+ */
+void print_error_list(const Error_list *list) {
+
+   const Validation_failure *failure;
+   char line_number_string[COUNT_STRING_LENGTH];
+   char byte_offset_string[COUNT_STRING_LENGTH];
+   char total_string[COUNT_STRING_LENGTH];
+   int i;
+
+   printf("\n");
+
+   for(i = 0; i < list->count; i++) {
+      failure = &list->failures[i];
+
+      format_count(failure->line_number + 1, line_number_string);
+      format_count(failure->byte_offset, byte_offset_string);
+
+      if(failure->file_name != NULL) {
+         printf("%s:", failure->file_name);
+      }
+
+      printf("%s: byte %s: error %d: %s\n", line_number_string,
+         byte_offset_string, failure->reason,
+         get_validation_error_reason(failure->reason));
+   }
+
+   format_count(list->total, total_string);
+
+   printf("\n%s %s failed validation.", total_string,
+      list->total == 1 ? "line" : "lines");
+
+   if(list->total > (Uint64) list->count) {
+      printf(" Only the first %d are listed.", list->count);
+   }
+
+   printf("\n");
+}
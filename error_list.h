@@ -0,0 +1,58 @@
+/*
+ * Name:       error_list.h
+ *
+ * Purpose:    Typedefs, macros and function definitions for error_list.c.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#ifndef ERROR_LIST_H
+
+#define ERROR_LIST_H
+
+#include "integer_types.h"
+
+/*
+ * Only this many bad lines are kept, however many there are. The rest are
+ * just counted.
+ */
+#define MAX_LISTED_ERRORS 1000
+
+/*
+ * One line that failed validation. line_number is zero-based, like
+ * Ingest_result's line_count, and byte_offset is where the line starts.
+ * reason is one of the validation errors in validate_budget_line.h.
+ * file_name is NULL unless several files are being read together.
+ */
+typedef struct {
+   const char *file_name;
+   Uint64 line_number;
+   Uint64 byte_offset;
+   int reason;
+} Validation_failure;
+
+/*
+ * The first MAX_LISTED_ERRORS bad lines, in the order they appear, and how
+ * many bad lines there are in all.
+ */
+typedef struct {
+   Validation_failure failures[MAX_LISTED_ERRORS];
+   int count;
+   Uint64 total;
+} Error_list;
+
+void init_error_list(Error_list *list);
+void add_validation_failure(Error_list *list, Uint64 line_number,
+   Uint64 byte_offset, int reason);
+void merge_error_list(Error_list *total, const Error_list *list,
+   const char *file_name, Uint64 line_offset, Uint64 byte_offset);
+void print_error_list(const Error_list *list);
+
+#endif
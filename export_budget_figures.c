@@ -0,0 +1,195 @@
+/*
+ * Name:       export_budget_figures.c
+ *
+ * Purpose:    Write the yearly, large transaction and monthly figures in a
+ *             form meant for other programs rather than people.
+ *
+ *             Every format has one row per year or month, with the same rows
+ *             the tables would show:
+ *                csv    a header line, then lines of
+ *                       table,year,month,credits,debits,margins
+ *                jsonl  one JSON object per line with the same fields
+ *                bin    a Figures_header and then Figures_records (see
+ *                       export_budget_figures.h)
+ *
+ *             In csv and jsonl, table is yearly, yearly_average, large or
+ *             monthly, month is left out for a whole year, and the amounts
+ *             are in dollars and cents, exactly as in the tables. In bin, the
+ *             table is a number and the amounts are in cents.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#include <string.h>
+#include "program_init.h"
+#include "export_budget_figures.h"
+
+#define FIGURES_MAGIC "c_budfig"
+#define FIGURES_VERSION 1
+#define FIGURES_BYTE_ORDER 0x01020304UL
+
+void export_figures_row(Report_writer *writer, int format, int table,
+   int year, int month, Cents credits, Cents debits, Cents margins);
+const char *get_table_name(int table);
+
+void export_budget_figures(Report_writer *writer, const Ledger *ledger,
+   int format) {
+
+   int year;
+   int i;
+   int first_month = ledger->first_used_month;
+   int last_month = ledger->last_used_month;
+   const Month_figures *month_figures;
+   Month_figures year_figures;
+   Figures_header header;
+
+   if(ledger->used == FALSE) {
+      last_month = first_month - 1;
+   }
+
+   if(format == CSV_FORMAT) {
+      write_report_text(writer, "table,year,month,credits,debits,margins\n");
+   }
+   else if(format == BINARY_FORMAT) {
+      (void) memset(&header, 0, sizeof(Figures_header));
+      (void) memcpy(header.magic, FIGURES_MAGIC, sizeof(header.magic));
+      header.version = FIGURES_VERSION;
+      header.byte_order = FIGURES_BYTE_ORDER;
+      header.record_size = sizeof(Figures_record);
+
+      write_report_bytes(writer, (const char *) &header,
+         sizeof(Figures_header));
+   }
+
+   for(year = first_month / 12; year <= last_month / 12; year++) {
+      get_year_figures(ledger, year, &year_figures);
+
+      if(year_figures.credits != 0 || year_figures.debits != 0) {
+         export_figures_row(writer, format, YEARLY_TOTALS_TABLE, year, 0,
+            year_figures.credits, year_figures.debits,
+            year_figures.credits + year_figures.debits);
+      }
+   }
+
+   for(year = first_month / 12; year <= last_month / 12; year++) {
+      get_year_figures(ledger, year, &year_figures);
+
+      if(year_figures.credits != 0 || year_figures.debits != 0) {
+         export_figures_row(writer, format, YEARLY_AVERAGES_TABLE, year, 0,
+            divide_cents(year_figures.credits, 12),
+            divide_cents(year_figures.debits, 12),
+            divide_cents(year_figures.credits + year_figures.debits, 12));
+      }
+   }
+
+   for(i = first_month; i <= last_month; i++) {
+      month_figures = &ledger->months[i - ledger->first_month];
+
+      if(month_figures->large_credits != 0
+         || month_figures->large_debits != 0) {
+
+         export_figures_row(writer, format, LARGE_TRANSACTIONS_TABLE, i / 12,
+            i % 12 + 1, month_figures->large_credits,
+            month_figures->large_debits,
+            month_figures->large_credits + month_figures->large_debits);
+      }
+   }
+
+   for(i = first_month; i <= last_month; i++) {
+      month_figures = &ledger->months[i - ledger->first_month];
+
+      if(month_figures->credits != 0 || month_figures->debits != 0) {
+         export_figures_row(writer, format, MONTHLY_TRANSACTIONS_TABLE,
+            i / 12, i % 12 + 1, month_figures->credits,
+            month_figures->debits,
+            month_figures->credits + month_figures->debits);
+      }
+   }
+}
+
+/*
+ * Write one row in the given format. A month of 0 means the whole year.
+ */
+void export_figures_row(Report_writer *writer, int format, int table,
+   int year, int month, Cents credits, Cents debits, Cents margins) {
+
+   Figures_record record;
+
+   if(format == BINARY_FORMAT) {
+      record.table = table;
+      record.year = year;
+      record.month = month;
+      record.reserved = 0;
+      record.credits = credits;
+      record.debits = debits;
+      record.margins = margins;
+
+      write_report_bytes(writer, (const char *) &record,
+         sizeof(Figures_record));
+
+      return;
+   }
+
+   if(format == CSV_FORMAT) {
+      write_report_text(writer, get_table_name(table));
+      write_report_text(writer, ",");
+      write_report_number(writer, year, 0);
+      write_report_text(writer, ",");
+
+      if(month != 0) {
+         write_report_number(writer, month, 0);
+      }
+
+      write_report_text(writer, ",");
+      write_report_cents(writer, credits, 0);
+      write_report_text(writer, ",");
+      write_report_cents(writer, debits, 0);
+      write_report_text(writer, ",");
+      write_report_cents(writer, margins, 0);
+      write_report_text(writer, "\n");
+
+      return;
+   }
+
+   write_report_text(writer, "{\"table\":\"");
+   write_report_text(writer, get_table_name(table));
+   write_report_text(writer, "\",\"year\":");
+   write_report_number(writer, year, 0);
+
+   if(month != 0) {
+      write_report_text(writer, ",\"month\":");
+      write_report_number(writer, month, 0);
+   }
+
+   write_report_text(writer, ",\"credits\":");
+   write_report_cents(writer, credits, 0);
+   write_report_text(writer, ",\"debits\":");
+   write_report_cents(writer, debits, 0);
+   write_report_text(writer, ",\"margins\":");
+   write_report_cents(writer, margins, 0);
+   write_report_text(writer, "}\n");
+}
+
+const char *get_table_name(int table) {
+
+   switch(table) {
+      case YEARLY_TOTALS_TABLE:
+         return "yearly";
+
+      case YEARLY_AVERAGES_TABLE:
+         return "yearly_average";
+
+      case LARGE_TRANSACTIONS_TABLE:
+         return "large";
+
+      default:
+         return "monthly";
+   }
+}
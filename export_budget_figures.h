@@ -0,0 +1,69 @@
+/*
+ * Name:       export_budget_figures.h
+ *
+ * Purpose:    Typedefs, macros and function definitions for
+ *             export_budget_figures.c.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#ifndef EXPORT_BUDGET_FIGURES_H
+
+#define EXPORT_BUDGET_FIGURES_H
+
+#include "integer_types.h"
+#include "cents.h"
+#include "ledger.h"
+#include "report_writer.h"
+
+/*
+ * Which table a row of figures comes from.
+ */
+#define YEARLY_TOTALS_TABLE 1
+#define YEARLY_AVERAGES_TABLE 2
+#define LARGE_TRANSACTIONS_TABLE 3
+#define MONTHLY_TRANSACTIONS_TABLE 4
+
+/*
+ * The start of the binary format. Everything in it is in the byte order of
+ * the computer that wrote it, which byte_order shows (0x01020304 reads back
+ * as 0x04030201 on a computer with the other byte order).
+ *
+ * The header is followed by nothing but Figures_records, each record_size
+ * bytes long, so the number of records is the rest of the file's size
+ * divided by record_size.
+ */
+typedef struct {
+   char magic[8];
+   Uint32 version;
+   Uint32 byte_order;
+   Uint32 record_size;
+   Uint32 reserved;
+} Figures_header;
+
+/*
+ * One row of a table. month is from 1 to 12, or 0 for a whole year. The
+ * amounts are in cents. Every field is on a multiple of its own size, so
+ * the records can be used in place.
+ */
+typedef struct {
+   Int32 table;
+   Int32 year;
+   Int32 month;
+   Int32 reserved;
+   Cents credits;
+   Cents debits;
+   Cents margins;
+} Figures_record;
+
+void export_budget_figures(Report_writer *writer, const Ledger *ledger,
+   int format);
+
+#endif
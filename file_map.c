@@ -0,0 +1,151 @@
+/*
+ * Name:       file_map.c
+ *
+ * Purpose:    Memory-map a regular file so it can be read in place, without
+ *             copying it into a buffer first.
+ *
+ *             map_file returns FALSE when the file can't be mapped. This
+ *             includes files that aren't regular files (pipes, terminals,
+ *             etc.) and every file on platforms without mmap, so callers
+ *             should always be prepared to read the file with stdio instead.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include "platform.h"
+#include "file_map.h"
+
+#ifdef POSIX_PLATFORM
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#ifdef POSIX_PLATFORM
+
+Bool map_file(const char *file_name, File_map *map) {
+
+   int fd;
+   struct stat file_status;
+   void *data;
+
+   map->data = NULL;
+   map->length = 0;
+
+   fd = open(file_name, O_RDONLY);
+
+   if(fd == -1) {
+      return FALSE;
+   }
+
+   /*
+    * Only regular files can be mapped. Also make sure the file fits in the
+    * address space (this only matters for very large files on 32-bit
+    * systems).
+    */
+   if(fstat(fd, &file_status) == -1 || !S_ISREG(file_status.st_mode)
+      || (off_t) (size_t) file_status.st_size != file_status.st_size) {
+
+      (void) close(fd);
+      return FALSE;
+   }
+
+   if(file_status.st_size == 0) {
+      (void) close(fd);
+      return TRUE;
+   }
+
+   data = mmap(NULL, (size_t) file_status.st_size, PROT_READ, MAP_PRIVATE,
+      fd, 0);
+
+   /*
+    * The mapping stays valid after the file descriptor is closed.
+    */
+   (void) close(fd);
+
+   if(data == MAP_FAILED) {
+      return FALSE;
+   }
+
+   /*
+    * The budget file is read once from front to back, so let the kernel read
+    * ahead aggressively and drop pages behind us.
+    */
+   (void) posix_madvise(data, (size_t) file_status.st_size,
+      POSIX_MADV_SEQUENTIAL);
+
+   map->data = data;
+   map->length = (size_t) file_status.st_size;
+
+   return TRUE;
+}
+
+void unmap_file(File_map *map) {
+
+   if(map->data != NULL) {
+      (void) munmap((void *) map->data, map->length);
+   }
+
+   map->data = NULL;
+   map->length = 0;
+}
+
+/*
+ * Get the size and last modification time of a regular file. Return FALSE if
+ * file_name isn't a regular file or can't be looked at.
+ */
+Bool get_file_status(const char *file_name, Uint64 *size,
+   Int64 *modification_time) {
+
+   struct stat file_status;
+
+   if(stat(file_name, &file_status) == -1 || !S_ISREG(file_status.st_mode)) {
+      return FALSE;
+   }
+
+   *size = (Uint64) file_status.st_size;
+   *modification_time = (Int64) file_status.st_mtime;
+
+   return TRUE;
+}
+
+#else
+
+Bool map_file(const char *file_name, File_map *map) {
+
+   (void) file_name;
+
+   map->data = NULL;
+   map->length = 0;
+
+   return FALSE;
+}
+
+void unmap_file(File_map *map) {
+
+   map->data = NULL;
+   map->length = 0;
+}
+
+Bool get_file_status(const char *file_name, Uint64 *size,
+   Int64 *modification_time) {
+
+   (void) file_name;
+
+   *size = 0;
+   *modification_time = 0;
+
+   return FALSE;
+}
+
+#endif
@@ -0,0 +1,38 @@
+/*
+ * Name:       file_map.h
+ *
+ * Purpose:    Typedef and function definitions for file_map.c.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#ifndef FILE_MAP_H
+
+#define FILE_MAP_H
+
+#include <stddef.h>
+#include "boolean.h"
+#include "integer_types.h"
+
+/*
+ * A read-only view of an entire file. An empty file is mapped as a NULL data
+ * pointer with a length of 0.
+ */
+typedef struct {
+   const char *data;
+   size_t length;
+} File_map;
+
+Bool map_file(const char *file_name, File_map *map);
+void unmap_file(File_map *map);
+Bool get_file_status(const char *file_name, Uint64 *size,
+   Int64 *modification_time);
+
+#endif
@@ -0,0 +1,274 @@
+/*
+ * Name:       follow.c
+ *
+ * Purpose:    Keep reading a budget data file as lines are added to it, and
+ *             display the budget figures again each time they change.
+ *
+ *             Only the new lines are validated and added to the ledger. A
+ *             line that is still being written (with no new line character
+ *             yet) waits until it is finished. On Linux, c_budget sleeps
+ *             until inotify says the file has changed. Elsewhere, it checks
+ *             the file every FOLLOW_POLL_SECONDS.
+ *
+ *             If the file is replaced, as most editors do when saving by
+ *             renaming a new copy over it, or is truncated or rewritten, the
+ *             new file is read again from the start.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include "platform.h"
+#include "return_codes.h"
+#include "print_budget_figures.h"
+#include "follow.h"
+
+#ifdef POSIX_PLATFORM
+#include <errno.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+int start_watching(void);
+int watch_data_file(int watch_fd, int old_watch, const char *data_file_name);
+void wait_for_change(int watch_fd, int watch);
+void stop_watching(int watch_fd);
+
+/*
+ * Read reader to the end and display the figures, then keep waiting for
+ * more lines and displaying the figures again whenever there are any. If the
+ * file is replaced, or what has been read so far is no longer in it,
+ * everything is read again from the start.
+ *
+ * This only returns if something goes wrong. The return value and result
+ * are the same as for ingest_budget_lines, with line numbers counted from
+ * the start of the file.
+ */
+int follow_budget_file(Line_reader *reader, const Program_options *options,
+   Ledger *ledger, Ingest_result *result) {
+
+   Ingest_result new_lines_result;
+   Uint64 line_count = 0;
+   Bool ledger_changed = TRUE;
+   Bool start_again;
+   int watch_fd;
+   int watch;
+   int return_code = 0;
+
+   follow_line_reader(reader);
+
+   watch_fd = start_watching();
+   watch = watch_data_file(watch_fd, -1, options->data_file_name);
+
+   for(;;) {
+      start_again = FALSE;
+
+      /*
+       * Until a deleted file is back, the old one is kept and the name is
+       * checked every FOLLOW_POLL_SECONDS.
+       */
+      if(is_line_reader_replaced(reader, options->data_file_name) == TRUE) {
+         if(reopen_line_reader(reader, options->data_file_name) == TRUE) {
+            watch = watch_data_file(watch_fd, watch,
+               options->data_file_name);
+            start_again = TRUE;
+         }
+         else {
+            watch = watch_data_file(watch_fd, watch, NULL);
+         }
+      }
+      else if(is_line_reader_rewritten(reader) == TRUE) {
+         if(restart_line_reader(reader) == FALSE) {
+            return_code = FILE_ERROR;
+            break;
+         }
+
+         start_again = TRUE;
+      }
+
+      if(start_again == TRUE) {
+         free_ledger(ledger);
+         line_count = 0;
+         ledger_changed = TRUE;
+      }
+
+      return_code = ingest_budget_lines(reader, ledger, NULL, NULL,
+         &new_lines_result);
+
+      result->validation_error = new_lines_result.validation_error;
+      result->line_count = line_count + new_lines_result.line_count;
+      result->byte_count = reader->offset;
+
+      if(return_code != 0) {
+         break;
+      }
+
+      if(new_lines_result.line_count > 0) {
+         ledger_changed = TRUE;
+      }
+
+      line_count = result->line_count;
+
+      mark_line_reader_end(reader);
+
+      if(ledger_changed == TRUE) {
+         if(display_budget_figures(ledger, options) != 0) {
+            printf("\nThe budget figures could not be written to %s.\n",
+               options->output_file_name != NULL ? options->output_file_name
+               : "standard output");
+         }
+
+         (void) fflush(stdout);
+
+         ledger_changed = FALSE;
+      }
+
+      wait_for_change(watch_fd, watch);
+   }
+
+   stop_watching(watch_fd);
+
+   return return_code;
+}
+
+#ifdef __linux__
+
+/*
+ * Return a file descriptor to wait on for changes to the budget file, or -1
+ * if changes can't be watched for.
+ */
+int start_watching(void) {
+
+   return inotify_init();
+}
+
+/*
+ * Stop watching old_watch, if it isn't -1, and start watching
+ * data_file_name, if it isn't NULL. Besides changes to the file, a watch
+ * wakes c_budget when the file is renamed, deleted or has its links changed,
+ * which is what happens when another file is renamed over it.
+ *
+ * Return the new watch, or -1 if there isn't one.
+ */
+int watch_data_file(int watch_fd, int old_watch, const char *data_file_name) {
+
+   if(watch_fd == -1) {
+      return -1;
+   }
+
+   if(old_watch != -1) {
+      (void) inotify_rm_watch(watch_fd, old_watch);
+   }
+
+   if(data_file_name == NULL) {
+      return -1;
+   }
+
+   return inotify_add_watch(watch_fd, data_file_name,
+      IN_MODIFY | IN_MOVE_SELF | IN_DELETE_SELF | IN_ATTRIB);
+}
+
+/*
+ * Wait for the next change to the budget file. Several changes may be
+ * reported at once; the caller checks the file either way. Without a watch,
+ * just wait FOLLOW_POLL_SECONDS.
+ */
+void wait_for_change(int watch_fd, int watch) {
+
+   char events[4096];
+
+   if(watch_fd == -1 || watch == -1) {
+      (void) sleep(FOLLOW_POLL_SECONDS);
+
+      return;
+   }
+
+   while(read(watch_fd, events, sizeof(events)) == -1) {
+      if(errno != EINTR) {
+         (void) sleep(FOLLOW_POLL_SECONDS);
+
+         return;
+      }
+   }
+}
+
+void stop_watching(int watch_fd) {
+
+   if(watch_fd != -1) {
+      (void) close(watch_fd);
+   }
+}
+
+#elif defined(POSIX_PLATFORM)
+
+int start_watching(void) {
+
+   return -1;
+}
+
+int watch_data_file(int watch_fd, int old_watch, const char *data_file_name) {
+
+   (void) watch_fd;
+   (void) old_watch;
+   (void) data_file_name;
+
+   return -1;
+}
+
+void wait_for_change(int watch_fd, int watch) {
+
+   (void) watch_fd;
+   (void) watch;
+
+   (void) sleep(FOLLOW_POLL_SECONDS);
+}
+
+void stop_watching(int watch_fd) {
+
+   (void) watch_fd;
+}
+
+#else
+
+/*
+ * Following needs a budget file that is read in blocks, which is only done
+ * on POSIX platforms (see program_init.c), so none of these are ever used.
+ */
+int start_watching(void) {
+
+   return -1;
+}
+
+int watch_data_file(int watch_fd, int old_watch, const char *data_file_name) {
+
+   (void) watch_fd;
+   (void) old_watch;
+   (void) data_file_name;
+
+   return -1;
+}
+
+void wait_for_change(int watch_fd, int watch) {
+
+   (void) watch_fd;
+   (void) watch;
+}
+
+void stop_watching(int watch_fd) {
+
+   (void) watch_fd;
+}
+
+#endif
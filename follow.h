@@ -0,0 +1,34 @@
+/*
+ * Name:       follow.h
+ *
+ * Purpose:    Macros and function definitions for follow.c.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#ifndef FOLLOW_H
+
+#define FOLLOW_H
+
+#include "line_reader.h"
+#include "ledger.h"
+#include "ingest_budget_data.h"
+#include "program_init.h"
+
+/*
+ * How often the budget file is checked for new lines where it can't be
+ * watched for changes.
+ */
+#define FOLLOW_POLL_SECONDS 1
+
+int follow_budget_file(Line_reader *reader, const Program_options *options,
+   Ledger *ledger, Ingest_result *result);
+
+#endif
@@ -0,0 +1,547 @@
+/*
+ * Name:       generate_budget_data.c
+ *
+ * Purpose:    Write made-up budget data for testing how fast c_budget is.
+ *
+ *             generate_budget_data is a separate program from c_budget. It
+ *             writes lines in the same form as budget_data_sample.txt, with
+ *             random dates, amounts and descriptions. The same options and
+ *             seed always give exactly the same file, so results can be
+ *             compared from one version of c_budget to the next.
+ *
+ *             generate_budget_data is run from the command line as shown
+ *             below. Every option has a default, shown in brackets:
+ *                generate_budget_data [options] [-o file]
+ *                   -h, --help               print these options and exit
+ *                   -n LINES                 number of lines, from 1 to
+ *                                            1000000000 [1000]
+ *                   --seed N                 random number seed [1]
+ *                   --first-year YEAR        first year of dates [2000]
+ *                   --years N                number of years of dates [10]
+ *                   --max-amount DOLLARS     largest amount, up to 99999
+ *                                            [5000]
+ *                   --distribution NAME      uniform, or skewed for mostly
+ *                                            small amounts with a few large
+ *                                            ones [skewed]
+ *                   --descriptions N         number of different
+ *                                            descriptions [100]
+ *                   --invalid-percent P      percentage of lines that fail
+ *                                            validation [0]
+ *
+ *             Without -o, the data is written to standard output. Any other
+ *             option prints the list above and fails.
+ *
+ *             About one amount in five is a credit and the rest are debits.
+ *             Invalid lines have one of a few common mistakes: a missing
+ *             pipe, dashes in the date, a letter in the amount or a month of
+ *             13.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "boolean.h"
+#include "integer_types.h"
+#include "return_codes.h"
+
+#define MAX_LINE_COUNT 1000000000UL
+#define MAX_AMOUNT_DOLLARS 99999L
+#define MAX_DESCRIPTION_COUNT 1000000L
+#define MIN_YEAR 1
+#define MAX_YEAR 9999
+
+/*
+ * Returned by get_generator_options after -h or --help, which isn't an error.
+ */
+#define HELP_PRINTED -1
+
+#define UNIFORM_DISTRIBUTION 0
+#define SKEWED_DISTRIBUTION 1
+
+/*
+ * xorshift64* constants, built up from 32-bit halves for C89.
+ */
+#define SEED_MULTIPLIER (((Uint64) 0x9e3779b9UL << 32) | 0x7f4a7c15UL)
+#define RANDOM_MULTIPLIER (((Uint64) 0x2545f491UL << 32) | 0x4f6cdd1dUL)
+
+#define CREDIT_PERCENT 20
+#define INVALID_LINE_KINDS 4
+
+/*
+ * Lines are built up in memory and written out this many bytes at a time.
+ */
+#define OUTPUT_BUFFER_SIZE (1024 * 1024)
+
+/*
+ * Long enough for any line this program writes.
+ */
+#define MAX_GENERATED_LINE_LENGTH 64
+
+typedef struct {
+   unsigned long line_count;
+   unsigned long seed;
+   int first_year;
+   int year_count;
+   long max_amount;
+   int distribution;
+   long description_count;
+   double invalid_percent;
+   const char *output_file_name;
+} Generator_options;
+
+int get_generator_options(int argument_count, char **argument_vector,
+   Generator_options *options);
+Bool is_generator_option(const char *argument);
+void print_generator_usage(void);
+Bool get_long_argument(const char *argument, long minimum, long maximum,
+   long *number);
+Uint64 get_random_number(Uint64 *state);
+double get_random_fraction(Uint64 *state);
+size_t write_budget_line(char *line, Uint64 *state,
+   const Generator_options *options);
+size_t write_digits(char *s, unsigned long number, int minimum_digits);
+int get_days_in_month(int month, int year);
+
+int main(int argc, char **argv)
+{
+   Generator_options options;
+   Uint64 state;
+   FILE *fp = stdout;
+   char *buffer;
+   size_t used = 0;
+   unsigned long i;
+   int return_code = 0;
+
+   return_code = get_generator_options(argc, argv, &options);
+
+   if(return_code == HELP_PRINTED) {
+      return 0;
+   }
+
+   if(return_code != 0) {
+      return return_code;
+   }
+
+   buffer = malloc(OUTPUT_BUFFER_SIZE);
+
+   if(buffer == NULL) {
+      printf("\nThere was an error getting the required memory.\n");
+
+      return MEMORY_ERROR;
+   }
+
+   if(options.output_file_name != NULL) {
+      fp = fopen(options.output_file_name, "wb");
+
+      if(fp == NULL) {
+         printf("\n%s could not be opened for writing.\n",
+            options.output_file_name);
+
+         free(buffer);
+
+         return FILE_ERROR;
+      }
+   }
+
+   /*
+    * Never start from a state of 0, which the generator can't get out of.
+    * Nearby seeds start out alike, so throw away the first few numbers.
+    */
+   state = (Uint64) options.seed * SEED_MULTIPLIER + 1;
+
+   for(i = 0; i < 16; i++) {
+      (void) get_random_number(&state);
+   }
+
+   for(i = 0; i < options.line_count && return_code == 0; i++) {
+      used += write_budget_line(buffer + used, &state, &options);
+
+      if(used > OUTPUT_BUFFER_SIZE - MAX_GENERATED_LINE_LENGTH
+         || i + 1 == options.line_count) {
+
+         if(fwrite(buffer, 1, used, fp) != used) {
+            return_code = FILE_ERROR;
+         }
+
+         used = 0;
+      }
+   }
+
+   if(fflush(fp) != 0) {
+      return_code = FILE_ERROR;
+   }
+
+   if(fp != stdout && fclose(fp) != 0) {
+      return_code = FILE_ERROR;
+   }
+
+   if(return_code != 0) {
+      printf("\nThere was an error writing the budget data.\n");
+   }
+
+   free(buffer);
+
+   return return_code;
+}
+
+/*
+ * Fill in options from the command-line arguments.
+ *
+ * Return 0 if they are all valid, or HELP_PRINTED after -h or --help.
+ * Return ARGUMENT_ERROR, otherwise.
+ */
+int get_generator_options(int argument_count, char **argument_vector,
+   Generator_options *options) {
+
+   int i;
+   long number;
+   char *end_ptr;
+   const char *argument;
+   const char *value;
+
+   options->line_count = 1000;
+   options->seed = 1;
+   options->first_year = 2000;
+   options->year_count = 10;
+   options->max_amount = 5000;
+   options->distribution = SKEWED_DISTRIBUTION;
+   options->description_count = 100;
+   options->invalid_percent = 0.0;
+   options->output_file_name = NULL;
+
+   for(i = 1; i < argument_count; i++) {
+      argument = argument_vector[i];
+      value = i + 1 < argument_count ? argument_vector[i + 1] : NULL;
+
+      if(strcmp(argument, "-h") == 0 || strcmp(argument, "--help") == 0) {
+         print_generator_usage();
+
+         return HELP_PRINTED;
+      }
+
+      if(is_generator_option(argument) == FALSE) {
+         printf("\nUnknown option %s.\n", argument);
+         print_generator_usage();
+
+         return ARGUMENT_ERROR;
+      }
+
+      if(value == NULL) {
+         printf("\n%s must be followed by a value.\n", argument);
+
+         return ARGUMENT_ERROR;
+      }
+
+      i++;
+
+      if(strcmp(argument, "-n") == 0) {
+         options->line_count = strtoul(value, &end_ptr, 10);
+
+         if(end_ptr == value || *end_ptr != '\0' || value[0] == '-'
+            || options->line_count < 1
+            || options->line_count > MAX_LINE_COUNT) {
+
+            printf("\n-n must be followed by a number of lines from 1 to");
+            printf(" %lu.\n", MAX_LINE_COUNT);
+
+            return ARGUMENT_ERROR;
+         }
+      }
+      else if(strcmp(argument, "--seed") == 0) {
+         options->seed = strtoul(value, &end_ptr, 10);
+
+         if(end_ptr == value || *end_ptr != '\0' || value[0] == '-') {
+            printf("\n--seed must be followed by a whole number.\n");
+
+            return ARGUMENT_ERROR;
+         }
+      }
+      else if(strcmp(argument, "--first-year") == 0) {
+         if(get_long_argument(value, MIN_YEAR, MAX_YEAR, &number) == FALSE) {
+            printf("\n--first-year must be followed by a year from %d to",
+               MIN_YEAR);
+            printf(" %d.\n", MAX_YEAR);
+
+            return ARGUMENT_ERROR;
+         }
+
+         options->first_year = (int) number;
+      }
+      else if(strcmp(argument, "--years") == 0) {
+         if(get_long_argument(value, 1, MAX_YEAR, &number) == FALSE) {
+            printf("\n--years must be followed by a number of years.\n");
+
+            return ARGUMENT_ERROR;
+         }
+
+         options->year_count = (int) number;
+      }
+      else if(strcmp(argument, "--max-amount") == 0) {
+         if(get_long_argument(value, 1, MAX_AMOUNT_DOLLARS, &number)
+            == FALSE) {
+
+            printf("\n--max-amount must be followed by a number of dollars");
+            printf(" from 1 to %ld.\n", MAX_AMOUNT_DOLLARS);
+
+            return ARGUMENT_ERROR;
+         }
+
+         options->max_amount = number;
+      }
+      else if(strcmp(argument, "--distribution") == 0) {
+         if(strcmp(value, "uniform") == 0) {
+            options->distribution = UNIFORM_DISTRIBUTION;
+         }
+         else if(strcmp(value, "skewed") == 0) {
+            options->distribution = SKEWED_DISTRIBUTION;
+         }
+         else {
+            printf("\n--distribution must be followed by uniform or");
+            printf(" skewed.\n");
+
+            return ARGUMENT_ERROR;
+         }
+      }
+      else if(strcmp(argument, "--descriptions") == 0) {
+         if(get_long_argument(value, 1, MAX_DESCRIPTION_COUNT, &number)
+            == FALSE) {
+
+            printf("\n--descriptions must be followed by a number from 1 to");
+            printf(" %ld.\n", MAX_DESCRIPTION_COUNT);
+
+            return ARGUMENT_ERROR;
+         }
+
+         options->description_count = number;
+      }
+      else if(strcmp(argument, "--invalid-percent") == 0) {
+         options->invalid_percent = strtod(value, &end_ptr);
+
+         if(end_ptr == value || *end_ptr != '\0'
+            || options->invalid_percent < 0.0
+            || options->invalid_percent > 100.0) {
+
+            printf("\n--invalid-percent must be followed by a percentage");
+            printf(" from 0 to 100.\n");
+
+            return ARGUMENT_ERROR;
+         }
+      }
+      else if(strcmp(argument, "-o") == 0) {
+         options->output_file_name = value;
+      }
+   }
+
+   if(options->first_year + options->year_count - 1 > MAX_YEAR) {
+      printf("\nThe last year of dates can't be after %d.\n", MAX_YEAR);
+
+      return ARGUMENT_ERROR;
+   }
+
+   return 0;
+}
+
+/*
+ * Return TRUE if argument is one of the options that takes a value.
+ */
+Bool is_generator_option(const char *argument) {
+   static const char *names[] = {
+      "-n", "--seed", "--first-year", "--years", "--max-amount",
+      "--distribution", "--descriptions", "--invalid-percent", "-o"
+   };
+   size_t i;
+
+   for(i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+      if(strcmp(argument, names[i]) == 0) {
+         return TRUE;
+      }
+   }
+
+   return FALSE;
+}
+
+/*
+ * Print every option, with its default in brackets.
+ */
+void print_generator_usage(void) {
+   printf("\nUsage: generate_budget_data [options] [-o file]\n");
+   printf("   -h, --help               print these options and exit\n");
+   printf("   -n LINES                 number of lines, from 1 to %lu [1000]\n",
+      MAX_LINE_COUNT);
+   printf("   --seed N                 random number seed [1]\n");
+   printf("   --first-year YEAR        first year of dates [2000]\n");
+   printf("   --years N                number of years of dates [10]\n");
+   printf("   --max-amount DOLLARS     largest amount, up to %ld [5000]\n",
+      MAX_AMOUNT_DOLLARS);
+   printf("   --distribution NAME      uniform, or skewed for mostly small");
+   printf(" amounts\n");
+   printf("                            with a few large ones [skewed]\n");
+   printf("   --descriptions N         number of different descriptions");
+   printf(" [100]\n");
+   printf("   --invalid-percent P      percentage of lines that fail");
+   printf(" validation [0]\n");
+   printf("   -o FILE                  file to write [standard output]\n");
+}
+
+Bool get_long_argument(const char *argument, long minimum, long maximum,
+   long *number) {
+
+   char *end_ptr;
+
+   *number = strtol(argument, &end_ptr, 10);
+
+   if(end_ptr == argument || *end_ptr != '\0' || *number < minimum
+      || *number > maximum) {
+
+      return FALSE;
+   }
+
+   return TRUE;
+}
+
+/*
+ * The next number from a xorshift64* generator. It is fast, has a period of
+ * 2^64 - 1 and gives the same numbers on every platform.
+ */
+Uint64 get_random_number(Uint64 *state) {
+
+   *state ^= *state >> 12;
+   *state ^= *state << 25;
+   *state ^= *state >> 27;
+
+   return *state * RANDOM_MULTIPLIER;
+}
+
+/*
+ * A random number from 0 up to but not including 1.
+ */
+double get_random_fraction(Uint64 *state) {
+
+   return (double) (get_random_number(state) >> 11) / 9007199254740992.0;
+}
+
+/*
+ * Write one line, new line character included, into line.
+ *
+ * Return the number of characters written.
+ */
+size_t write_budget_line(char *line, Uint64 *state,
+   const Generator_options *options) {
+
+   char *s = line;
+   int year;
+   int month;
+   int day;
+   unsigned long cents;
+   unsigned long max_cents = (unsigned long) options->max_amount * 100;
+   double fraction;
+   Bool credit;
+   int invalid_kind = -1;
+
+   if(options->invalid_percent > 0.0
+      && get_random_fraction(state) * 100.0 < options->invalid_percent) {
+
+      invalid_kind = (int) (get_random_number(state) % INVALID_LINE_KINDS);
+   }
+
+   year = options->first_year
+      + (int) (get_random_number(state) % options->year_count);
+   month = 1 + (int) (get_random_number(state) % 12);
+   day = 1 + (int) (get_random_number(state)
+      % get_days_in_month(month, year));
+
+   /*
+    * Skewed amounts are mostly small, like everyday spending, with the odd
+    * large one, like rent or a paycheck.
+    */
+   fraction = get_random_fraction(state);
+
+   if(options->distribution == SKEWED_DISTRIBUTION) {
+      fraction = fraction * fraction * fraction * fraction;
+   }
+
+   cents = 1 + (unsigned long) (fraction * (double) max_cents);
+
+   if(cents > max_cents) {
+      cents = max_cents;
+   }
+
+   credit = get_random_number(state) % 100 < CREDIT_PERCENT ? TRUE : FALSE;
+
+   s += write_digits(s, invalid_kind == 3 ? 13 : (unsigned long) month, 2);
+   *s++ = invalid_kind == 1 ? '-' : '/';
+   s += write_digits(s, (unsigned long) day, 2);
+   *s++ = invalid_kind == 1 ? '-' : '/';
+   s += write_digits(s, (unsigned long) year, 4);
+
+   if(invalid_kind != 0) {
+      *s++ = '|';
+   }
+
+   if(credit == FALSE) {
+      *s++ = '-';
+   }
+
+   s += write_digits(s, cents / 100, 1);
+   *s++ = '.';
+   s += write_digits(s, cents % 100, 2);
+
+   if(invalid_kind == 2) {
+      s[-1] = 'x';
+   }
+
+   (void) memcpy(s, "|Payee ", 7);
+   s += 7;
+   s += write_digits(s,
+      (unsigned long) (get_random_number(state) % options->description_count),
+      1);
+   *s++ = '\n';
+
+   return (size_t) (s - line);
+}
+
+/*
+ * Write number in decimal, with leading zeros up to minimum_digits.
+ *
+ * Return the number of characters written.
+ */
+size_t write_digits(char *s, unsigned long number, int minimum_digits) {
+
+   char digits[24];
+   int digit_count = 0;
+   size_t length;
+
+   do {
+      digits[digit_count++] = (char) ('0' + number % 10);
+      number /= 10;
+   } while(number > 0 || digit_count < minimum_digits);
+
+   length = (size_t) digit_count;
+
+   while(digit_count > 0) {
+      *s++ = digits[--digit_count];
+   }
+
+   return length;
+}
+
+int get_days_in_month(int month, int year) {
+
+   const int days_in_month[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30,
+      31 };
+
+   if(month == 2 && ((year % 4 == 0 && year % 100 != 0) || year % 400 == 0)) {
+      return 29;
+   }
+
+   return days_in_month[month - 1];
+}
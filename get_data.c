@@ -1,182 +1,75 @@
-/*
- * Name:       get_data.c
- *
- * Purpose:    Functions for fullfilling requests for data, such as getting the
- *             date or amount from the budget transaction line.
- *
- * Author:     jjones4
- *
- * Copyright (c) 2024 Jerad Jones
- *
- * This file is part of c_budget. c_budget may be freely distributed under the
- * MIT license. For all details and documentation, see:
- *
- *             https://github.com/jjones4/c_budget
- */
-
-#include <stdio.h>
-#include <stdlib.h>
-#include "get_data.h"
-#include "return_codes.h"
-#include "size_limits.h"
-
-int get_month(const char *date_string, int *error_code) {
-
-   int month = 0;
-   char *month_string = NULL;
-   char *month_string_ptr;
-   char *temp_ptr;
-
-   month_string = malloc(MONTH_LENGTH * sizeof(char));
-   month_string_ptr = month_string;
-
-   if(month_string == NULL) {
-      *error_code = MEMORY_ERROR;
-      return 0;
-   }
-
-   while(*date_string != '/') {
-      *month_string = *date_string;
-      ++month_string;
-      ++date_string;
-   }
-
-   *month_string = '\0';
-
-   month = strtol(month_string_ptr, &temp_ptr, 10);
-
-   free(month_string_ptr);
-
-   return month;
-}
-
-int get_day(const char *date_string, int *error_code) {
-
-   int day = 0;
-   char *day_string = NULL;
-   char *day_string_ptr;
-   char *temp_ptr;
-
-   day_string = malloc(DAY_LENGTH * sizeof(char));
-   day_string_ptr = day_string;
-
-   if(day_string == NULL) {
-      *error_code = MEMORY_ERROR;
-      return 0;
-   }
-
-   /*
-    * Skip to the first character after the first forward slash.
-    */
-   while(*date_string != '/') {
-      ++date_string;
-   }
-
-   ++date_string;
-
-   while(*date_string != '/') {
-      *day_string = *date_string;
-      ++day_string;
-      ++date_string;
-   }
-
-   *day_string = '\0';
-
-   day = strtol(day_string_ptr, &temp_ptr, 10);
-
-   free(day_string_ptr);
-      
-   return day;
-}
-
-int get_year(const char *date_string, int *error_code) {
-
-   int year = 0;
-   char *year_string = NULL;
-   char *year_string_ptr;
-   char *temp_ptr;
-
-   year_string = malloc(YEAR_LENGTH * sizeof(char));
-   year_string_ptr = year_string;
-
-   if(year_string == NULL) {
-      *error_code = MEMORY_ERROR;
-      return 0;
-   }
-
-   /*
-    * Skip to the first character after the first forward slash.
-    */
-   while(*date_string != '/') {
-      ++date_string;
-   }
-
-   ++date_string;
-
-   /*
-    * Skip to the first character after the second forward slash.
-    */
-   while(*date_string != '/') {
-      ++date_string;
-   }
-
-   ++date_string;
-
-   while(*date_string) {
-      *year_string = *date_string;
-      ++year_string;
-      ++date_string;
-   }
-
-   *year_string = '\0';
-
-   year = strtol(year_string_ptr, &temp_ptr, 10);
-
-   free(year_string_ptr);
-
-   return year;
-}
-
-double get_amount(const char *amount_string) {
-
-   double amount = 0.00;
-   char *ptr;
-   
-   amount = strtod(amount_string, &ptr);
-
-   return amount;
-}
-
-void get_amount_string(const char *line, char *amount_string) {
-
-   /*
-    * Skip to the character directly after the first pipe.
-    */
-   while(*line != '|') {
-      ++line;
-   }
-
-   ++line;
-
-   /*
-    * Start filling the amount string.
-    */
-   while(*line != '|') {
-      *amount_string = *line;
-      ++amount_string;
-      ++line;
-   }
-
-   *amount_string = '\0';
-}
-
-void get_date_string(const char *line, char *date_string) {
-
-   while(*line != '|') {
-      *date_string = *line;
-      ++date_string;
-      ++line;
-   }
-
-   *date_string = '\0';
-}
+/*
+ * Name:       get_data.c
+ *
+ * Purpose:    Functions for fullfilling requests for data, such as getting the
+ *             date or amount from the budget transaction line.
+ *
+ *             These functions read the fields in place. They assume the line
+ *             has already been checked by the validator, so each field is
+ *             known to be where it belongs and to contain only digits.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#include "boolean.h"
+#include "get_data.h"
+
+int get_month(const char *line) {
+
+   line += MONTH_OFFSET;
+
+   return (line[0] - '0') * 10 + (line[1] - '0');
+}
+
+int get_day(const char *line) {
+
+   line += DAY_OFFSET;
+
+   return (line[0] - '0') * 10 + (line[1] - '0');
+}
+
+int get_year(const char *line) {
+
+   line += YEAR_OFFSET;
+
+   return (line[0] - '0') * 1000 + (line[1] - '0') * 100
+      + (line[2] - '0') * 10 + (line[3] - '0');
+}
+
+/*
+ * The amount has already been checked to be an optional minus sign, digits, a
+ * decimal point and exactly two more digits, so leaving out the decimal point
+ * gives the amount in cents.
+ */
+Cents get_amount(const char *amount_string, size_t amount_length) {
+
+   Cents amount = 0;
+   Bool negative = FALSE;
+   const char *amount_end = amount_string + amount_length;
+
+   if(*amount_string == '-') {
+      negative = TRUE;
+      ++amount_string;
+   }
+
+   while(amount_string < amount_end) {
+      if(*amount_string != '.') {
+         amount = amount * 10 + (*amount_string - '0');
+      }
+
+      ++amount_string;
+   }
+
+   if(negative == TRUE) {
+      return -amount;
+   }
+
+   return amount;
+}
@@ -1,27 +1,38 @@
-/*
- * Name:       return_codes.h
- *
- * Purpose:    Header file for get_data.c.
- *
- * Author:     jjones4
- *
- * Copyright (c) 2024 Jerad Jones
- *
- * This file is part of c_budget. c_budget may be freely distributed under the
- * MIT license. For all details and documentation, see:
- *
- *             https://github.com/jjones4/c_budget
- */
-
-#ifndef GET_DATA_H
-
-#define GET_DATA_H
-
-void get_date_string(const char *line, char *date_string);
-void get_amount_string(const char *line, char *amount_string);
-int get_month(const char *date_string, int *error_code);
-int get_day(const char *date_string, int *error_code);
-int get_year(const char *date_string, int *error_code);
-double get_amount(const char *amount_string);
-
-#endif
\ No newline at end of file
+/*
+ * Name:       get_data.h
+ *
+ * Purpose:    Header file for get_data.c.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#ifndef GET_DATA_H
+
+#define GET_DATA_H
+
+#include <stddef.h>
+#include "cents.h"
+
+/*
+ * Offsets of each field from the start of a budget line. The date is always
+ * in the form mm/dd/yyyy, so everything up to the amount is at a fixed
+ * position.
+ */
+#define MONTH_OFFSET 0
+#define DAY_OFFSET 3
+#define YEAR_OFFSET 6
+#define AMOUNT_OFFSET 11
+
+int get_month(const char *line);
+int get_day(const char *line);
+int get_year(const char *line);
+Cents get_amount(const char *amount_string, size_t amount_length);
+
+#endif
@@ -0,0 +1,33 @@
+/*
+ * Name:       hash.h
+ *
+ * Purpose:    Macros and function definitions for hash.c.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#ifndef HASH_H
+
+#define HASH_H
+
+#include <stddef.h>
+#include "integer_types.h"
+
+/*
+ * Starting value for hash_bytes (the 64-bit FNV-1a offset basis). C89 has no
+ * 64-bit constants, so it is put together from two halves.
+ */
+#define HASH_START (((Uint64) 0xcbf29ce4UL << 32) | 0x84222325UL)
+
+Uint64 hash_bytes(const char *data, size_t length, Uint64 hash);
+Uint64 hash_all(const char *data, size_t length);
+Uint64 hash_string(const char *string, size_t length);
+
+#endif
@@ -0,0 +1,445 @@
+/*
+ * Name:       ingest_budget_data.c
+ *
+ * Purpose:    Read, validate and add up every line of budget data.
+ *
+ *             A budget file that is already in memory can be split into
+ *             pieces which are read by several threads at once. Each thread
+ *             adds up its own ledger. When all of the threads are done, their
+ *             ledgers are merged in file order, so the results don't depend on
+ *             which thread finished first.
+ *
+ *             Nothing is printed here. The caller reports any errors, since
+ *             only the caller knows the line number a thread's error is on.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <assert.h>
+#include <string.h>
+#include "platform.h"
+#include "return_codes.h"
+#include "budget_memory.h"
+#include "validate_budget_line.h"
+#include "ingest_budget_data.h"
+
+#ifdef POSIX_PLATFORM
+#include <pthread.h>
+#endif
+
+/*
+ * The piece of a budget file read by one thread.
+ */
+typedef struct {
+   const char *data;
+   size_t length;
+   Ledger *ledger;
+   Error_list *errors;
+   Ingest_result result;
+   int return_code;
+} Ingest_chunk;
+
+unsigned long get_growth_count(const Ledger *ledger,
+   const Cache_writer *cache_writer);
+size_t find_chunk_boundary(const char *data, size_t length, size_t position);
+void *ingest_chunk(void *argument);
+void run_chunks(Ingest_chunk *chunks, int thread_count);
+void read_chunks_in_order(Ingest_chunk *chunks, int thread_count);
+unsigned long get_chunk_growth_count(const Ingest_chunk *chunks,
+   int thread_count);
+
+/*
+ * Read every line from reader, stopping at the first line that fails
+ * validation. If errors isn't NULL, bad lines are added to it and skipped
+ * instead. If cache_writer isn't NULL, every transaction is also handed to
+ * it (see budget_cache.c). If ledger is NULL, the lines are only validated.
+ *
+ * Return 0 if every line is valid. Return applicable error code, otherwise
+ * (see return_codes.h).
+ */
+int ingest_budget_lines(Line_reader *reader, Ledger *ledger,
+   Cache_writer *cache_writer, Error_list *errors, Ingest_result *result) {
+
+   int read_budget_lines_result = 0;
+   unsigned long allocation_count_before_reading = 0;
+   unsigned long growth_count_before_reading = 0;
+
+   /*
+    * Nothing in the reading loop may allocate memory, since it runs once for
+    * every line in the budget data file. The only exceptions are the ledger
+    * growing to fit a new range of dates and the cache's description table
+    * growing, each of which happens a handful of times per file at most.
+    */
+   allocation_count_before_reading = get_allocation_count();
+   growth_count_before_reading = get_growth_count(ledger, cache_writer);
+
+   read_budget_lines_result = read_budget_lines(reader, ledger, cache_writer,
+      errors, result);
+
+   assert(get_allocation_count() - allocation_count_before_reading
+      == get_growth_count(ledger, cache_writer) - growth_count_before_reading);
+
+   return read_budget_lines_result;
+}
+
+/*
+ * The reading loop itself. Threads reading parts of a file, or whole files,
+ * in parallel call this directly, since the allocation count is shared
+ * between all of them.
+ */
+int read_budget_lines(Line_reader *reader, Ledger *ledger,
+   Cache_writer *cache_writer, Error_list *errors, Ingest_result *result) {
+
+   Uint64 line_start = reader->offset;
+   const char *line;
+   size_t line_length = 0;
+   int calculate_budget_figures_result = 0;
+   int add_cached_transaction_result = 0;
+   Transaction transaction;
+
+   result->validation_error = 0;
+   result->line_count = 0;
+   result->byte_count = 0;
+   result->file_name = NULL;
+
+   while(get_next_line(reader, &line, &line_length) == TRUE) {
+      result->byte_count = reader->offset;
+      result->validation_error = parse_budget_line(line, line_length,
+         &transaction);
+
+      if(result->validation_error != 0) {
+         if(errors == NULL) {
+            return DATA_VALIDATION_ERROR;
+         }
+
+         /*
+          * A line too long for the reader's buffer may have been handed out
+          * in pieces. Only the first piece counts as the bad line.
+          */
+         if(result->validation_error == LINE_TERMINATION_ERROR) {
+            skip_rest_of_line(reader);
+            result->byte_count = reader->offset;
+         }
+
+         add_validation_failure(errors, result->line_count, line_start,
+            result->validation_error);
+
+         result->validation_error = 0;
+         result->line_count++;
+         line_start = reader->offset;
+
+         continue;
+      }
+
+      if(ledger != NULL) {
+         calculate_budget_figures_result = calculate_budget_figures(
+            &transaction, ledger);
+
+         if(calculate_budget_figures_result != 0) {
+            return calculate_budget_figures_result;
+         }
+      }
+
+      if(cache_writer != NULL) {
+         add_cached_transaction_result = add_cached_transaction(cache_writer,
+            &transaction);
+
+         if(add_cached_transaction_result != 0) {
+            return add_cached_transaction_result;
+         }
+      }
+
+      result->line_count++;
+      line_start = reader->offset;
+   }
+
+   if(reader->read_error == TRUE) {
+      return FILE_ERROR;
+   }
+
+   return 0;
+}
+
+/*
+ * Number of allocations made so far by the things that are allowed to grow
+ * while lines are being read.
+ */
+unsigned long get_growth_count(const Ledger *ledger,
+   const Cache_writer *cache_writer) {
+
+   unsigned long growth_count = 0;
+
+   if(ledger != NULL) {
+      growth_count += get_ledger_growth_count(ledger);
+   }
+
+   if(cache_writer != NULL) {
+      growth_count += cache_writer->strings.growth_count;
+   }
+
+   return growth_count;
+}
+
+/*
+ * Split data into one piece per thread, with every piece ending on a line
+ * boundary, and read the pieces at the same time. ledger must be initialized
+ * by the caller, or be NULL to only validate the lines.
+ *
+ * The return value, result and errors are the same as if the whole of data
+ * had been read by ingest_budget_lines.
+ */
+int ingest_budget_data_in_parallel(const char *data, size_t length,
+   int thread_count, Ledger *ledger, Error_list *errors,
+   Ingest_result *result) {
+
+   int i;
+   int return_code = 0;
+   size_t start = 0;
+   size_t end = 0;
+   Ingest_chunk *chunks;
+   Error_list *chunk_errors = NULL;
+
+   chunks = budget_malloc(thread_count * sizeof(Ingest_chunk));
+
+   if(errors != NULL && chunks != NULL) {
+      chunk_errors = budget_malloc(thread_count * sizeof(Error_list));
+
+      if(chunk_errors == NULL) {
+         budget_free(chunks);
+         chunks = NULL;
+      }
+   }
+
+   if(chunks == NULL) {
+      return MEMORY_ERROR;
+   }
+
+   for(i = 0; i < thread_count; i++) {
+      chunks[i].ledger = NULL;
+
+      if(ledger != NULL) {
+         chunks[i].ledger = budget_malloc(sizeof(Ledger));
+      }
+
+      if(ledger != NULL && chunks[i].ledger == NULL) {
+         while(i-- > 0) {
+            free_ledger(chunks[i].ledger);
+            budget_free(chunks[i].ledger);
+         }
+
+         budget_free(chunks);
+         budget_free(chunk_errors);
+         return MEMORY_ERROR;
+      }
+
+      if(ledger != NULL) {
+         init_ledger(chunks[i].ledger, &ledger->options);
+      }
+
+      chunks[i].errors = NULL;
+
+      if(chunk_errors != NULL) {
+         chunks[i].errors = &chunk_errors[i];
+         init_error_list(chunks[i].errors);
+      }
+
+      end = find_chunk_boundary(data, length,
+         (size_t) ((double) length * (i + 1) / thread_count));
+
+      chunks[i].data = data + start;
+      chunks[i].length = end - start;
+
+      start = end;
+   }
+
+   run_chunks(chunks, thread_count);
+
+   /*
+    * Put the results back together in file order. Every piece before the
+    * first one with an error was read all the way through, so its line count
+    * is complete and the error's line number comes out the same as if the
+    * file had been read by a single thread.
+    */
+   result->validation_error = 0;
+   result->line_count = 0;
+   result->byte_count = 0;
+   result->file_name = NULL;
+
+   for(i = 0; i < thread_count; i++) {
+      if(ledger != NULL && merge_ledger(ledger, chunks[i].ledger) != 0) {
+         return_code = MEMORY_ERROR;
+         break;
+      }
+
+      if(chunks[i].errors != NULL) {
+         merge_error_list(errors, chunks[i].errors, NULL, result->line_count,
+            (Uint64) (chunks[i].data - data));
+      }
+
+      result->line_count += chunks[i].result.line_count;
+      result->byte_count += chunks[i].result.byte_count;
+
+      if(chunks[i].return_code != 0) {
+         result->validation_error = chunks[i].result.validation_error;
+         return_code = chunks[i].return_code;
+         break;
+      }
+   }
+
+   for(i = 0; i < thread_count && ledger != NULL; i++) {
+      free_ledger(chunks[i].ledger);
+      budget_free(chunks[i].ledger);
+   }
+
+   budget_free(chunks);
+   budget_free(chunk_errors);
+
+   return return_code;
+}
+
+/*
+ * Return the position just after the first new line character at or after
+ * position, or length if there isn't one.
+ */
+size_t find_chunk_boundary(const char *data, size_t length, size_t position) {
+
+   const char *new_line;
+
+   if(position >= length) {
+      return length;
+   }
+
+   new_line = memchr(data + position, '\n', length - position);
+
+   if(new_line == NULL) {
+      return length;
+   }
+
+   return (size_t) (new_line - data) + 1;
+}
+
+void *ingest_chunk(void *argument) {
+
+   Ingest_chunk *chunk = argument;
+   Line_reader reader;
+
+   open_memory_line_reader(&reader, chunk->data, chunk->length);
+
+   chunk->return_code = read_budget_lines(&reader, chunk->ledger, NULL,
+      chunk->errors, &chunk->result);
+
+   close_line_reader(&reader);
+
+   return NULL;
+}
+
+void read_chunks_in_order(Ingest_chunk *chunks, int thread_count) {
+
+   int i;
+
+   for(i = 0; i < thread_count; i++) {
+      (void) ingest_chunk(&chunks[i]);
+   }
+}
+
+/*
+ * The number of times the chunks' ledgers have grown so far. Reading the
+ * chunks must not allocate anything else, no matter how many threads are
+ * reading (see ingest_budget_lines).
+ */
+unsigned long get_chunk_growth_count(const Ingest_chunk *chunks,
+   int thread_count) {
+
+   unsigned long growth_count = 0;
+   int i;
+
+   for(i = 0; i < thread_count; i++) {
+      growth_count += get_growth_count(chunks[i].ledger, NULL);
+   }
+
+   return growth_count;
+}
+
+#ifdef POSIX_PLATFORM
+
+/*
+ * Give each chunk its own thread. The first chunk is read by the calling
+ * thread. If a thread can't be started, its chunk is read by the calling
+ * thread as well.
+ */
+void run_chunks(Ingest_chunk *chunks, int thread_count) {
+
+   int i;
+   pthread_t *threads;
+   Bool *thread_started;
+   unsigned long allocation_count_before_reading;
+   unsigned long growth_count_before_reading;
+
+   threads = budget_malloc(thread_count * sizeof(pthread_t));
+   thread_started = budget_malloc(thread_count * sizeof(Bool));
+
+   allocation_count_before_reading = get_allocation_count();
+   growth_count_before_reading = get_chunk_growth_count(chunks, thread_count);
+
+   if(threads == NULL || thread_started == NULL) {
+      read_chunks_in_order(chunks, thread_count);
+   }
+   else {
+      for(i = 1; i < thread_count; i++) {
+         thread_started[i] = FALSE;
+
+         if(pthread_create(&threads[i], NULL, ingest_chunk, &chunks[i])
+            == 0) {
+
+            thread_started[i] = TRUE;
+         }
+      }
+
+      (void) ingest_chunk(&chunks[0]);
+
+      for(i = 1; i < thread_count; i++) {
+         if(thread_started[i] == TRUE) {
+            (void) pthread_join(threads[i], NULL);
+         }
+         else {
+            (void) ingest_chunk(&chunks[i]);
+         }
+      }
+   }
+
+   assert(get_allocation_count() - allocation_count_before_reading
+      == get_chunk_growth_count(chunks, thread_count)
+      - growth_count_before_reading);
+
+   budget_free(threads);
+   budget_free(thread_started);
+}
+
+#else
+
+/*
+ * Without POSIX threads, the chunks are simply read one after another.
+ */
+void run_chunks(Ingest_chunk *chunks, int thread_count) {
+
+   unsigned long allocation_count_before_reading = get_allocation_count();
+   unsigned long growth_count_before_reading
+      = get_chunk_growth_count(chunks, thread_count);
+
+   read_chunks_in_order(chunks, thread_count);
+
+   assert(get_allocation_count() - allocation_count_before_reading
+      == get_chunk_growth_count(chunks, thread_count)
+      - growth_count_before_reading);
+}
+
+#endif
@@ -0,0 +1,59 @@
+/*
+ * Name:       ingest_budget_data.h
+ *
+ * Purpose:    Macros, typedef and function definitions for
+ *             ingest_budget_data.c.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#ifndef INGEST_BUDGET_DATA_H
+
+#define INGEST_BUDGET_DATA_H
+
+#include <stddef.h>
+#include "integer_types.h"
+#include "line_reader.h"
+#include "budget_calculations.h"
+#include "budget_cache.h"
+#include "error_list.h"
+
+/*
+ * What happened while reading budget data. If a line failed validation,
+ * validation_error says why (see validate_budget_line.h) and line_count is the
+ * number of lines before it, so it is also the zero-based number of the bad
+ * line. byte_count is the number of bytes read, including the bad line.
+ *
+ * When bad lines are being collected in an Error_list instead, reading goes
+ * on to the end, line_count counts the bad lines as well, and
+ * validation_error is left at 0.
+ *
+ * There is no limit on the number of lines. Both counts are 64 bits, and
+ * nothing read is kept once its line has been added to the ledger.
+ *
+ * When several files are read together, file_name is the file the result is
+ * for. Otherwise, it is NULL.
+ */
+typedef struct {
+   int validation_error;
+   Uint64 line_count;
+   Uint64 byte_count;
+   const char *file_name;
+} Ingest_result;
+
+int ingest_budget_lines(Line_reader *reader, Ledger *ledger,
+   Cache_writer *cache_writer, Error_list *errors, Ingest_result *result);
+int read_budget_lines(Line_reader *reader, Ledger *ledger,
+   Cache_writer *cache_writer, Error_list *errors, Ingest_result *result);
+int ingest_budget_data_in_parallel(const char *data, size_t length,
+   int thread_count, Ledger *ledger, Error_list *errors,
+   Ingest_result *result);
+
+#endif
@@ -0,0 +1,55 @@
+/*
+ * Name:       integer_types.h
+ *
+ * Purpose:    Typedefs for 32-bit and 64-bit integers.
+ *
+ *             c_budget is c89 compliant, and C89 has no 64-bit integer type
+ *             (long is only 32 bits on Windows and on 32-bit Linux). Every
+ *             compiler c_budget is built with has one as an extension, so use
+ *             that instead of <stdint.h>. A compiler with neither that nor a
+ *             64-bit long is refused, rather than silently getting 32-bit
+ *             totals.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#ifndef INTEGER_TYPES_H
+
+#define INTEGER_TYPES_H
+
+#include <limits.h>
+
+#if defined(_MSC_VER)
+typedef __int64 Int64;
+typedef unsigned __int64 Uint64;
+#elif defined(__GNUC__)
+__extension__ typedef long long Int64;
+__extension__ typedef unsigned long long Uint64;
+#elif ULONG_MAX > 0xffffffffUL
+typedef long Int64;
+typedef unsigned long Uint64;
+#else
+#error "c_budget needs a 64-bit integer type"
+#endif
+
+/*
+ * Fails to compile if Int64 or Uint64 isn't 64 bits, since every amount,
+ * total and byte offset would then overflow without any warning.
+ */
+typedef char int64_size_check[sizeof(Int64) == 8 ? 1 : -1];
+typedef char uint64_size_check[sizeof(Uint64) == 8 ? 1 : -1];
+
+/*
+ * int is 32 bits on every platform c_budget is built for.
+ */
+typedef int Int32;
+typedef unsigned int Uint32;
+
+#endif
@@ -0,0 +1,679 @@
+/*
+ * Name:       ledger.c
+ *
+ * Purpose:    Functions for setting up, growing, combining, summarizing and
+ *             saving ledgers.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#include <string.h>
+#include "return_codes.h"
+#include "budget_memory.h"
+#include "integer_types.h"
+#include "ledger.h"
+
+int grow_ledger(Ledger *ledger, int month_number);
+void clear_month_figures(Month_figures *month_figures);
+void clear_day_figures(Day_figures *day_figures);
+void add_month_figures(Month_figures *total,
+   const Month_figures *month_figures);
+
+void init_ledger(Ledger *ledger, const Ledger_options *options) {
+
+   ledger->options = *options;
+   ledger->months = NULL;
+   ledger->days = NULL;
+   ledger->sketches = NULL;
+   ledger->band_amounts = NULL;
+   ledger->first_month = 0;
+   ledger->month_count = 0;
+   ledger->used = FALSE;
+   ledger->first_used_month = 0;
+   ledger->last_used_month = 0;
+   ledger->growth_count = 0;
+   init_category_table(&ledger->categories);
+   init_top_transactions(&ledger->top, options->top_count);
+}
+
+/*
+ * Release everything the ledger holds, leaving it empty but keeping track of
+ * the same things as before.
+ */
+void free_ledger(Ledger *ledger) {
+
+   Ledger_options options = ledger->options;
+   int i;
+
+   for(i = 0; i < ledger->month_count && ledger->sketches != NULL; i++) {
+      budget_free(ledger->sketches[i]);
+   }
+
+   budget_free(ledger->months);
+   budget_free(ledger->days);
+   budget_free(ledger->sketches);
+   budget_free(ledger->band_amounts);
+   free_category_table(&ledger->categories);
+   free_top_transactions(&ledger->top);
+
+   init_ledger(ledger, &options);
+}
+
+/*
+ * Number of allocations the ledger has made so far as it grew.
+ */
+unsigned long get_ledger_growth_count(const Ledger *ledger) {
+
+   return ledger->growth_count
+      + get_category_growth_count(&ledger->categories)
+      + ledger->top.growth_count;
+}
+
+/*
+ * Return the figures for the given month (see MONTH_NUMBER in ledger.h),
+ * growing the ledger if needed, and mark the month as used. Return NULL if
+ * the ledger could not be grown.
+ */
+Month_figures *get_month_figures(Ledger *ledger, int month_number) {
+
+   int index = month_number - ledger->first_month;
+
+   if(index < 0 || index >= ledger->month_count) {
+      if(grow_ledger(ledger, month_number) != 0) {
+         return NULL;
+      }
+
+      index = month_number - ledger->first_month;
+   }
+
+   if(ledger->used == FALSE) {
+      ledger->used = TRUE;
+      ledger->first_used_month = month_number;
+      ledger->last_used_month = month_number;
+   }
+   else if(month_number < ledger->first_used_month) {
+      ledger->first_used_month = month_number;
+   }
+   else if(month_number > ledger->last_used_month) {
+      ledger->last_used_month = month_number;
+   }
+
+   return &ledger->months[index];
+}
+
+/*
+ * Return the figures for the given day (see DAY_NUMBER in ledger.h), or NULL
+ * if the ledger doesn't keep days or has no room for that day's month. Call
+ * get_month_figures first to make room for the month.
+ */
+Day_figures *get_day_figures(const Ledger *ledger, int day_number) {
+
+   int index = day_number - ledger->first_month * DAYS_PER_MONTH;
+
+   if(ledger->days == NULL || index < 0
+      || index >= ledger->month_count * DAYS_PER_MONTH) {
+
+      return NULL;
+   }
+
+   return &ledger->days[index];
+}
+
+/*
+ * Return the sketch of the given month's debits, allocating it if the month
+ * doesn't have one yet. Return NULL if it could not be allocated. Call
+ * get_month_figures first to make room for the month.
+ */
+Quantile_sketch *get_month_sketch(Ledger *ledger, int month_number) {
+
+   Quantile_sketch **sketch = &ledger->sketches[month_number
+      - ledger->first_month];
+
+   if(*sketch == NULL) {
+      *sketch = budget_malloc(sizeof(Quantile_sketch));
+
+      if(*sketch == NULL) {
+         return NULL;
+      }
+
+      clear_quantile_sketch(*sketch);
+      ledger->growth_count++;
+   }
+
+   return *sketch;
+}
+
+/*
+ * Return the band totals for the given month, which the ledger must have
+ * room for (see get_month_figures).
+ */
+Cents *get_band_amounts(const Ledger *ledger, int month_number) {
+
+   return &ledger->band_amounts[ledger->options.band_count
+      * (month_number - ledger->first_month)];
+}
+
+/*
+ * Add ledger into total, such as when combining the ledgers from each part of
+ * a budget file that was read in parallel.
+ *
+ * Return 0 if successful. Return MEMORY_ERROR if total could not be grown.
+ */
+int merge_ledger(Ledger *total, const Ledger *ledger) {
+
+   int i;
+   int j;
+   Month_figures *month_figures;
+   Day_figures *total_days;
+   const Day_figures *days;
+   Quantile_sketch *total_sketch;
+   const Quantile_sketch *sketch;
+   Cents *total_band_amounts;
+   const Cents *band_amounts;
+
+   if(ledger->options.categories == TRUE
+      && merge_category_table(&total->categories, &ledger->categories) != 0) {
+
+      return MEMORY_ERROR;
+   }
+
+   if(ledger->options.top_count > 0
+      && merge_top_transactions(&total->top, &ledger->top) != 0) {
+
+      return MEMORY_ERROR;
+   }
+
+   if(ledger->used == FALSE) {
+      return 0;
+   }
+
+   for(i = ledger->first_used_month; i <= ledger->last_used_month; i++) {
+      month_figures = get_month_figures(total, i);
+
+      if(month_figures == NULL) {
+         return MEMORY_ERROR;
+      }
+
+      add_month_figures(month_figures,
+         &ledger->months[i - ledger->first_month]);
+
+      if(ledger->options.days == TRUE) {
+         total_days = get_day_figures(total, DAYS_PER_MONTH * i);
+         days = get_day_figures(ledger, DAYS_PER_MONTH * i);
+
+         for(j = 0; j < DAYS_PER_MONTH; j++) {
+            total_days[j].credits += days[j].credits;
+            total_days[j].debits += days[j].debits;
+         }
+      }
+
+      if(ledger->options.quantiles == TRUE) {
+         sketch = ledger->sketches[i - ledger->first_month];
+
+         if(sketch != NULL) {
+            total_sketch = get_month_sketch(total, i);
+
+            if(total_sketch == NULL) {
+               return MEMORY_ERROR;
+            }
+
+            merge_quantile_sketch(total_sketch, sketch);
+         }
+      }
+
+      if(ledger->options.band_count > 0) {
+         total_band_amounts = get_band_amounts(total, i);
+         band_amounts = get_band_amounts(ledger, i);
+
+         for(j = 0; j < ledger->options.band_count; j++) {
+            total_band_amounts[j] += band_amounts[j];
+         }
+      }
+   }
+
+   return 0;
+}
+
+/*
+ * Add up the twelve months of the given year.
+ */
+void get_year_figures(const Ledger *ledger, int year,
+   Month_figures *year_figures) {
+
+   int i;
+   int index;
+
+   clear_month_figures(year_figures);
+
+   for(i = MONTH_NUMBER(year, 1); i <= MONTH_NUMBER(year, 12); i++) {
+      index = i - ledger->first_month;
+
+      if(index >= 0 && index < ledger->month_count) {
+         add_month_figures(year_figures, &ledger->months[index]);
+      }
+   }
+}
+
+/*
+ * Add up the sketches of the twelve months of the given year.
+ */
+void get_year_sketch(const Ledger *ledger, int year,
+   Quantile_sketch *year_sketch) {
+
+   int i;
+   int index;
+
+   clear_quantile_sketch(year_sketch);
+
+   for(i = MONTH_NUMBER(year, 1); i <= MONTH_NUMBER(year, 12); i++) {
+      index = i - ledger->first_month;
+
+      if(index >= 0 && index < ledger->month_count
+         && ledger->sketches[index] != NULL) {
+
+         merge_quantile_sketch(year_sketch, ledger->sketches[index]);
+      }
+   }
+}
+
+/*
+ * Write the options and used months of ledger to fp, followed by anything
+ * else the options say it keeps track of, in the byte order of this
+ * computer. Return FALSE if they could not all be written.
+ */
+Bool write_ledger(const Ledger *ledger, FILE *fp) {
+
+   Int32 header[9];
+   Int32 has_sketch;
+   size_t month_count;
+   size_t cutoff_count = (size_t) ledger->options.band_count;
+   int i;
+   const Quantile_sketch *sketch;
+
+   header[0] = ledger->options.categories == TRUE ? 1 : 0;
+   header[1] = ledger->options.normalize_categories == TRUE ? 1 : 0;
+   header[2] = ledger->used == TRUE ? 1 : 0;
+   header[3] = ledger->first_used_month;
+   header[4] = ledger->last_used_month;
+   header[5] = ledger->options.days == TRUE ? 1 : 0;
+   header[6] = ledger->options.top_count;
+   header[7] = ledger->options.quantiles == TRUE ? 1 : 0;
+   header[8] = ledger->options.band_count;
+
+   if(cutoff_count > 0) {
+      cutoff_count--;
+   }
+
+   if(fwrite(header, sizeof(Int32), 9, fp) != 9
+      || fwrite(ledger->options.band_cutoffs, sizeof(Cents), cutoff_count,
+      fp) != cutoff_count) {
+
+      return FALSE;
+   }
+
+   if(ledger->used == TRUE) {
+      month_count = (size_t) (ledger->last_used_month
+         - ledger->first_used_month + 1);
+
+      if(fwrite(&ledger->months[ledger->first_used_month
+         - ledger->first_month], sizeof(Month_figures), month_count, fp)
+         != month_count) {
+
+         return FALSE;
+      }
+
+      if(ledger->options.days == TRUE
+         && fwrite(get_day_figures(ledger,
+         DAYS_PER_MONTH * ledger->first_used_month), sizeof(Day_figures),
+         DAYS_PER_MONTH * month_count, fp) != DAYS_PER_MONTH * month_count) {
+
+         return FALSE;
+      }
+
+      for(i = ledger->first_used_month; i <= ledger->last_used_month
+         && ledger->options.quantiles == TRUE; i++) {
+
+         sketch = ledger->sketches[i - ledger->first_month];
+         has_sketch = sketch != NULL ? 1 : 0;
+
+         if(fwrite(&has_sketch, sizeof(Int32), 1, fp) != 1
+            || (sketch != NULL
+            && fwrite(sketch, sizeof(Quantile_sketch), 1, fp) != 1)) {
+
+            return FALSE;
+         }
+      }
+
+      if(ledger->options.band_count > 0
+         && fwrite(get_band_amounts(ledger, ledger->first_used_month),
+         sizeof(Cents), ledger->options.band_count * month_count, fp)
+         != ledger->options.band_count * month_count) {
+
+         return FALSE;
+      }
+   }
+
+   if(ledger->options.categories == TRUE
+      && write_category_table(&ledger->categories, fp) == FALSE) {
+
+      return FALSE;
+   }
+
+   if(ledger->options.top_count > 0
+      && write_top_transactions(&ledger->top, fp) == FALSE) {
+
+      return FALSE;
+   }
+
+   return TRUE;
+}
+
+/*
+ * Read a ledger written by write_ledger into ledger, which must be empty.
+ * The ledger that was written must have kept track of the same things as
+ * this one.
+ *
+ * Return 0 if successful. Return FILE_ERROR if fp doesn't hold a matching
+ * ledger, or MEMORY_ERROR if the ledger could not be grown. Either way,
+ * ledger may be partly filled in and should be freed.
+ */
+int read_ledger(FILE *fp, Ledger *ledger) {
+
+   Int32 header[9];
+   Int32 has_sketch;
+   Cents cutoff;
+   size_t month_count;
+   int i;
+   Quantile_sketch *sketch;
+   int return_code = 0;
+
+   if(fread(header, sizeof(Int32), 9, fp) != 9) {
+      return FILE_ERROR;
+   }
+
+   if(header[0] != (ledger->options.categories == TRUE ? 1 : 0)
+      || header[1] != (ledger->options.normalize_categories == TRUE ? 1 : 0)
+      || header[5] != (ledger->options.days == TRUE ? 1 : 0)
+      || header[6] != ledger->options.top_count
+      || header[7] != (ledger->options.quantiles == TRUE ? 1 : 0)
+      || header[8] != ledger->options.band_count) {
+
+      return FILE_ERROR;
+   }
+
+   for(i = 0; i < ledger->options.band_count - 1; i++) {
+      if(fread(&cutoff, sizeof(Cents), 1, fp) != 1
+         || cutoff != ledger->options.band_cutoffs[i]) {
+
+         return FILE_ERROR;
+      }
+   }
+
+   if(header[2] == 1) {
+      if(header[3] < 0 || header[3] > header[4]
+         || header[4] > LAST_MONTH_NUMBER) {
+
+         return FILE_ERROR;
+      }
+
+      /*
+       * Getting the first and last months makes room for everything between.
+       */
+      if(get_month_figures(ledger, header[3]) == NULL
+         || get_month_figures(ledger, header[4]) == NULL) {
+
+         return MEMORY_ERROR;
+      }
+
+      month_count = (size_t) (header[4] - header[3] + 1);
+
+      if(fread(&ledger->months[header[3] - ledger->first_month],
+         sizeof(Month_figures), month_count, fp) != month_count) {
+
+         return FILE_ERROR;
+      }
+
+      if(ledger->options.days == TRUE
+         && fread(get_day_figures(ledger, DAYS_PER_MONTH * header[3]),
+         sizeof(Day_figures), DAYS_PER_MONTH * month_count, fp)
+         != DAYS_PER_MONTH * month_count) {
+
+         return FILE_ERROR;
+      }
+
+      for(i = header[3]; i <= header[4]
+         && ledger->options.quantiles == TRUE; i++) {
+
+         if(fread(&has_sketch, sizeof(Int32), 1, fp) != 1) {
+            return FILE_ERROR;
+         }
+
+         if(has_sketch == 1) {
+            sketch = get_month_sketch(ledger, i);
+
+            if(sketch == NULL) {
+               return MEMORY_ERROR;
+            }
+
+            if(fread(sketch, sizeof(Quantile_sketch), 1, fp) != 1) {
+               return FILE_ERROR;
+            }
+         }
+         else if(has_sketch != 0) {
+            return FILE_ERROR;
+         }
+      }
+
+      if(ledger->options.band_count > 0
+         && fread(get_band_amounts(ledger, header[3]), sizeof(Cents),
+         ledger->options.band_count * month_count, fp)
+         != ledger->options.band_count * month_count) {
+
+         return FILE_ERROR;
+      }
+   }
+   else if(header[2] != 0) {
+      return FILE_ERROR;
+   }
+
+   if(ledger->options.categories == TRUE) {
+      return_code = read_category_table(fp, &ledger->categories);
+
+      if(return_code != 0) {
+         return return_code;
+      }
+   }
+
+   if(ledger->options.top_count > 0) {
+      return read_top_transactions(fp, &ledger->top);
+   }
+
+   return 0;
+}
+
+/*
+ * Make room for month_number. The ledger at least doubles in size, growing
+ * toward month_number, so a budget file spanning many years only causes a
+ * handful of allocations.
+ *
+ * Return 0 if successful. Return MEMORY_ERROR, otherwise.
+ */
+int grow_ledger(Ledger *ledger, int month_number) {
+
+   int i;
+   int low;
+   int high;
+   int new_first_month;
+   int new_month_count;
+   int offset;
+   Month_figures *new_months;
+   Day_figures *new_days = NULL;
+   Quantile_sketch **new_sketches = NULL;
+   Cents *new_band_amounts = NULL;
+
+   if(ledger->month_count == 0) {
+      low = month_number;
+      high = month_number + 1;
+   }
+   else {
+      low = ledger->first_month;
+      high = ledger->first_month + ledger->month_count;
+
+      if(month_number < low) {
+         low = month_number;
+      }
+
+      if(month_number >= high) {
+         high = month_number + 1;
+      }
+   }
+
+   new_month_count = 2 * ledger->month_count;
+
+   if(new_month_count < INITIAL_LEDGER_MONTHS) {
+      new_month_count = INITIAL_LEDGER_MONTHS;
+   }
+
+   if(new_month_count < high - low) {
+      new_month_count = high - low;
+   }
+
+   if(ledger->month_count > 0 && month_number < ledger->first_month) {
+      new_first_month = high - new_month_count;
+   }
+   else {
+      new_first_month = low;
+   }
+
+   /*
+    * Everything is allocated before anything is changed, so the ledger is
+    * left as it was if there isn't enough memory.
+    */
+   new_months = budget_malloc(new_month_count * sizeof(Month_figures));
+
+   if(ledger->options.days == TRUE) {
+      new_days = budget_malloc(DAYS_PER_MONTH * new_month_count
+         * sizeof(Day_figures));
+   }
+
+   if(ledger->options.quantiles == TRUE) {
+      new_sketches = budget_malloc(new_month_count
+         * sizeof(Quantile_sketch *));
+   }
+
+   if(ledger->options.band_count > 0) {
+      new_band_amounts = budget_malloc(ledger->options.band_count
+         * new_month_count * sizeof(Cents));
+   }
+
+   if(new_months == NULL
+      || (ledger->options.days == TRUE && new_days == NULL)
+      || (ledger->options.quantiles == TRUE && new_sketches == NULL)
+      || (ledger->options.band_count > 0 && new_band_amounts == NULL)) {
+
+      budget_free(new_months);
+      budget_free(new_days);
+      budget_free(new_sketches);
+      budget_free(new_band_amounts);
+
+      return MEMORY_ERROR;
+   }
+
+   offset = ledger->first_month - new_first_month;
+
+   if(new_days != NULL) {
+      for(i = 0; i < DAYS_PER_MONTH * new_month_count; i++) {
+         clear_day_figures(&new_days[i]);
+      }
+
+      if(ledger->days != NULL) {
+         (void) memcpy(&new_days[DAYS_PER_MONTH * offset], ledger->days,
+            DAYS_PER_MONTH * ledger->month_count * sizeof(Day_figures));
+
+         budget_free(ledger->days);
+      }
+
+      ledger->days = new_days;
+      ledger->growth_count++;
+   }
+
+   if(new_sketches != NULL) {
+      for(i = 0; i < new_month_count; i++) {
+         new_sketches[i] = NULL;
+      }
+
+      for(i = 0; i < ledger->month_count; i++) {
+         new_sketches[offset + i] = ledger->sketches[i];
+      }
+
+      budget_free(ledger->sketches);
+
+      ledger->sketches = new_sketches;
+      ledger->growth_count++;
+   }
+
+   if(new_band_amounts != NULL) {
+      for(i = 0; i < ledger->options.band_count * new_month_count; i++) {
+         new_band_amounts[i] = 0;
+      }
+
+      if(ledger->band_amounts != NULL) {
+         (void) memcpy(&new_band_amounts[ledger->options.band_count
+            * offset], ledger->band_amounts, ledger->options.band_count
+            * ledger->month_count * sizeof(Cents));
+
+         budget_free(ledger->band_amounts);
+      }
+
+      ledger->band_amounts = new_band_amounts;
+      ledger->growth_count++;
+   }
+
+   for(i = 0; i < new_month_count; i++) {
+      clear_month_figures(&new_months[i]);
+   }
+
+   if(ledger->months != NULL) {
+      (void) memcpy(&new_months[offset], ledger->months,
+         ledger->month_count * sizeof(Month_figures));
+
+      budget_free(ledger->months);
+   }
+
+   ledger->months = new_months;
+   ledger->first_month = new_first_month;
+   ledger->month_count = new_month_count;
+   ledger->growth_count++;
+
+   return 0;
+}
+
+/*
+ * The figures are written to checkpoints whole (see write_ledger), so any
+ * padding is zeroed along with them.
+ */
+void clear_month_figures(Month_figures *month_figures) {
+
+   (void) memset(month_figures, 0, sizeof(Month_figures));
+}
+
+void clear_day_figures(Day_figures *day_figures) {
+
+   (void) memset(day_figures, 0, sizeof(Day_figures));
+}
+
+void add_month_figures(Month_figures *total,
+   const Month_figures *month_figures) {
+
+   total->credits += month_figures->credits;
+   total->debits += month_figures->debits;
+   total->large_credits += month_figures->large_credits;
+   total->large_debits += month_figures->large_debits;
+}
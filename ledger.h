@@ -0,0 +1,156 @@
+/*
+ * Name:       ledger.h
+ *
+ * Purpose:    Typedefs and function definitions for ledger.c.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#ifndef LEDGER_H
+
+#define LEDGER_H
+
+#include <stdio.h>
+#include "boolean.h"
+#include "cents.h"
+#include "categories.h"
+#include "top_transactions.h"
+#include "quantiles.h"
+
+/*
+ * Months are numbered from January of year 0, so month number 12 * year +
+ * month - 1 is the given month of the given year.
+ */
+#define MONTH_NUMBER(year, month) (12 * (year) + (month) - 1)
+
+/*
+ * Number of months a ledger starts out with room for.
+ */
+#define INITIAL_LEDGER_MONTHS 120
+
+/*
+ * Latest month a budget file can have a transaction in (December 9999).
+ */
+#define LAST_MONTH_NUMBER MONTH_NUMBER(9999, 12)
+
+/*
+ * Every month has room for 31 days, so day number 31 * month number + day - 1
+ * is the given day. The days that don't exist in shorter months are simply
+ * never used.
+ */
+#define DAYS_PER_MONTH 31
+#define DAY_NUMBER(year, month, day) \
+   (DAYS_PER_MONTH * MONTH_NUMBER(year, month) + (day) - 1)
+#define LAST_DAY_NUMBER DAY_NUMBER(9999, 12, 31)
+
+/*
+ * Most amount bands that can be given with --bands, which is one more than
+ * the number of amounts separating them.
+ */
+#define MAX_AMOUNT_BANDS 16
+
+/*
+ * Everything added up for one month. Margins are not stored, since they are
+ * always the credits plus the debits. Keeping a month to 32 bytes puts two
+ * months in each cache line, and a transaction only ever touches one of them.
+ */
+typedef struct {
+   Cents credits;
+   Cents debits;
+   Cents large_credits;
+   Cents large_debits;
+} Month_figures;
+
+/*
+ * Everything added up for one day. Unlike the monthly figures, large
+ * transactions are counted in with the rest.
+ */
+typedef struct {
+   Cents credits;
+   Cents debits;
+} Day_figures;
+
+/*
+ * What a ledger keeps track of beyond the monthly figures, which it always
+ * keeps.
+ */
+typedef struct {
+   Bool categories;
+   Bool normalize_categories;
+   Bool days;
+   int top_count;
+   Bool quantiles;
+   int band_count;
+   Cents band_cutoffs[MAX_AMOUNT_BANDS - 1];
+} Ledger_options;
+
+/*
+ * All of the figures calculated for a budget file, one Month_figures per
+ * month. Yearly figures are added up from the months when they are needed.
+ *
+ * The months array only covers the dates actually found in the data. It
+ * starts out empty and grows (doubling in size each time) whenever a
+ * transaction falls outside of it. first_used_month and last_used_month are
+ * the earliest and latest months with a transaction in them; they mean
+ * nothing while used is FALSE.
+ *
+ * If options.days is TRUE, days holds DAYS_PER_MONTH Day_figures for each
+ * month in months, so a day's figures are at index day number - first_month
+ * * DAYS_PER_MONTH.
+ *
+ * If options.quantiles is TRUE, sketches has a pointer for each month in
+ * months to a sketch of the sizes of that month's debits. A month's sketch
+ * is only allocated once it has a debit, so the rest are NULL.
+ *
+ * If options.band_count isn't 0, band_amounts holds band_count totals for
+ * each month in months. An amount is in band i if it is at least
+ * options.band_cutoffs[i - 1] and less than options.band_cutoffs[i].
+ *
+ * If options.categories is TRUE, the figures for each description are kept
+ * in categories as well.
+ *
+ * If options.top_count isn't 0, the largest credits and debits are kept in
+ * top.
+ *
+ * Each thread reading part of a budget file adds up its own ledger, and the
+ * ledgers are merged at the end.
+ */
+typedef struct {
+   Ledger_options options;
+   Month_figures *months;
+   Day_figures *days;
+   Quantile_sketch **sketches;
+   Cents *band_amounts;
+   int first_month;
+   int month_count;
+   Bool used;
+   int first_used_month;
+   int last_used_month;
+   unsigned long growth_count;
+   Category_table categories;
+   Top_transactions top;
+} Ledger;
+
+void init_ledger(Ledger *ledger, const Ledger_options *options);
+void free_ledger(Ledger *ledger);
+unsigned long get_ledger_growth_count(const Ledger *ledger);
+Month_figures *get_month_figures(Ledger *ledger, int month_number);
+Day_figures *get_day_figures(const Ledger *ledger, int day_number);
+Quantile_sketch *get_month_sketch(Ledger *ledger, int month_number);
+Cents *get_band_amounts(const Ledger *ledger, int month_number);
+int merge_ledger(Ledger *total, const Ledger *ledger);
+void get_year_figures(const Ledger *ledger, int year,
+   Month_figures *year_figures);
+void get_year_sketch(const Ledger *ledger, int year,
+   Quantile_sketch *year_sketch);
+Bool write_ledger(const Ledger *ledger, FILE *fp);
+int read_ledger(FILE *fp, Ledger *ledger);
+
+#endif
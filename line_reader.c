@@ -0,0 +1,631 @@
+/*
+ * Name:       line_reader.c
+ *
+ * Purpose:    Hand out the lines of the budget data file one at a time.
+ *
+ *             Regular files are memory-mapped, and each line is handed out as
+ *             a pointer into the mapping plus a length, without being copied.
+ *             Standard input, pipes and other files that can't be mapped are
+ *             read in large blocks into a buffer that is reused for the whole
+ *             file. On platforms without POSIX system calls, anything that
+ *             can't be mapped is read with fgets instead.
+ *
+ *             Memory use doesn't depend on the size of the input when the file
+ *             is read in blocks, so the caller can ask for that even for a
+ *             regular file.
+ *
+ *             A line reader can also be opened on part of a file that is
+ *             already in memory, such as the piece of a mapped file that one
+ *             thread is responsible for.
+ *
+ *             Either way, a line never includes its new line character and is
+ *             only valid until the next call to get_next_line.
+ *
+ *             A file being read in blocks can also be followed as it is
+ *             written to, picking up new lines as they are added.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <string.h>
+#include "platform.h"
+#include "return_codes.h"
+#include "budget_memory.h"
+#include "hash.h"
+#include "line_reader.h"
+
+#ifdef POSIX_PLATFORM
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
+
+int open_stream_reader(Line_reader *reader, const char *file_name,
+   Bool standard_input);
+Bool get_next_mapped_line(Line_reader *reader, const char **line,
+   size_t *line_length);
+Bool get_next_stream_line(Line_reader *reader, const char **line,
+   size_t *line_length);
+Bool get_next_stdio_line(Line_reader *reader, const char **line,
+   size_t *line_length);
+Bool hash_bytes_before(Line_reader *reader, Uint64 end, Uint64 *hash);
+void reset_stream_position(Line_reader *reader);
+
+/*
+ * Return 0 if the file could be opened. Return applicable error code,
+ * otherwise (see return_codes.h). The file is only memory-mapped if
+ * allow_mapping is TRUE.
+ */
+int open_line_reader(Line_reader *reader, const char *file_name,
+   Bool allow_mapping) {
+
+   Bool standard_input = FALSE;
+
+   reader->read_error = FALSE;
+   reader->following = FALSE;
+   reader->line_cut_short = FALSE;
+   reader->offset = 0;
+   reader->fp = NULL;
+   reader->position = 0;
+   reader->fd = -1;
+   reader->stream_buffer = NULL;
+   reader->stream_end = 0;
+   reader->end_of_stream = FALSE;
+   reader->marked_offset = 0;
+   reader->allocation_count = 0;
+
+   if(strcmp(file_name, STANDARD_INPUT_FILE_NAME) == 0) {
+      standard_input = TRUE;
+   }
+
+   if(standard_input == FALSE && allow_mapping == TRUE
+      && map_file(file_name, &reader->map) == TRUE) {
+      reader->type = MAPPED_READER;
+
+      return 0;
+   }
+
+#ifdef POSIX_PLATFORM
+   return open_stream_reader(reader, file_name, standard_input);
+#else
+   reader->type = STDIO_READER;
+
+   if(standard_input == TRUE) {
+      reader->fp = stdin;
+   }
+   else {
+      reader->fp = fopen(file_name, "r");
+   }
+
+   if(reader->fp == NULL) {
+      return FILE_ERROR;
+   }
+
+   return 0;
+#endif
+}
+
+/*
+ * Read lines out of data, which the caller owns and must keep valid until the
+ * reader is closed.
+ */
+void open_memory_line_reader(Line_reader *reader, const char *data,
+   size_t length) {
+
+   reader->type = MEMORY_READER;
+   reader->read_error = FALSE;
+   reader->following = FALSE;
+   reader->line_cut_short = FALSE;
+   reader->offset = 0;
+   reader->fp = NULL;
+   reader->map.data = data;
+   reader->map.length = length;
+   reader->position = 0;
+   reader->fd = -1;
+   reader->stream_buffer = NULL;
+   reader->stream_end = 0;
+   reader->end_of_stream = FALSE;
+   reader->marked_offset = 0;
+   reader->allocation_count = 0;
+}
+
+/*
+ * Return TRUE and point line at the next line of the file. Return FALSE at the
+ * end of the file, or if the file could not be read (in which case read_error
+ * is set).
+ */
+Bool get_next_line(Line_reader *reader, const char **line,
+   size_t *line_length) {
+
+   if(reader->type == MAPPED_READER || reader->type == MEMORY_READER) {
+      return get_next_mapped_line(reader, line, line_length);
+   }
+
+   if(reader->type == STREAM_READER) {
+      return get_next_stream_line(reader, line, line_length);
+   }
+
+   return get_next_stdio_line(reader, line, line_length);
+}
+
+/*
+ * If the last line handed out was cut short, throw away the rest of it, so
+ * the next line handed out is the next whole line.
+ */
+void skip_rest_of_line(Line_reader *reader) {
+
+   const char *line;
+   size_t line_length;
+
+   while(reader->line_cut_short == TRUE) {
+      if(get_next_line(reader, &line, &line_length) == FALSE) {
+         reader->line_cut_short = FALSE;
+      }
+   }
+}
+
+void close_line_reader(Line_reader *reader) {
+
+   if(reader->type == MAPPED_READER) {
+      unmap_file(&reader->map);
+   }
+   else if(reader->type == MEMORY_READER) {
+      reader->map.data = NULL;
+      reader->map.length = 0;
+   }
+   else if(reader->type == STREAM_READER) {
+      budget_free(reader->stream_buffer);
+      reader->stream_buffer = NULL;
+
+#ifdef POSIX_PLATFORM
+      if(reader->fd != STDIN_FILENO) {
+         (void) close(reader->fd);
+      }
+#endif
+
+      reader->fd = -1;
+   }
+   else if(reader->fp != NULL) {
+      if(reader->fp != stdin) {
+         (void) fclose(reader->fp);
+      }
+
+      reader->fp = NULL;
+   }
+}
+
+#ifdef POSIX_PLATFORM
+
+/*
+ * Follow a file being read in blocks as it is written to. Reaching the end of
+ * the file no longer ends the last line: a line without a new line character
+ * is held back until the rest of it arrives. Once get_next_line returns
+ * FALSE, it can be called again later to pick up whatever has been added to
+ * the file since.
+ */
+void follow_line_reader(Line_reader *reader) {
+
+   reader->following = TRUE;
+}
+
+/*
+ * Return TRUE if what has already been read is no longer in the file: the
+ * file is now shorter than that, or the bytes just before where reading
+ * stopped (see mark_line_reader_end) have changed, such as when the file has
+ * been truncated and written again.
+ */
+Bool is_line_reader_rewritten(Line_reader *reader) {
+
+   struct stat file_status;
+   Uint64 hash;
+
+   if(fstat(reader->fd, &file_status) == -1) {
+      return FALSE;
+   }
+
+   if((Uint64) file_status.st_size
+      < reader->offset + (reader->stream_end - reader->position)) {
+
+      return TRUE;
+   }
+
+   if(reader->marked_offset > 0 && reader->marked_offset <= reader->offset
+      && (hash_bytes_before(reader, reader->marked_offset, &hash) == FALSE
+      || hash != reader->marked_hash)) {
+
+      return TRUE;
+   }
+
+   return FALSE;
+}
+
+/*
+ * Remember a hash of the last FOLLOW_CHECK_SPAN bytes read, so that
+ * is_line_reader_rewritten can tell if they change.
+ */
+void mark_line_reader_end(Line_reader *reader) {
+
+   reader->marked_offset = reader->offset;
+
+   if(hash_bytes_before(reader, reader->marked_offset, &reader->marked_hash)
+      == FALSE) {
+
+      reader->marked_offset = 0;
+   }
+}
+
+/*
+ * Hash up to FOLLOW_CHECK_SPAN bytes of the file just before end, leaving
+ * the file where it was for the next block to be read.
+ */
+Bool hash_bytes_before(Line_reader *reader, Uint64 end, Uint64 *hash) {
+
+   char bytes[FOLLOW_CHECK_SPAN];
+   Uint64 start = end > FOLLOW_CHECK_SPAN ? end - FOLLOW_CHECK_SPAN : 0;
+   size_t length = (size_t) (end - start);
+   size_t used = 0;
+   ssize_t bytes_read;
+   off_t resume_offset;
+   Bool read_ok = TRUE;
+
+   resume_offset = lseek(reader->fd, 0, SEEK_CUR);
+
+   if(resume_offset == (off_t) -1
+      || lseek(reader->fd, (off_t) start, SEEK_SET) == (off_t) -1) {
+
+      return FALSE;
+   }
+
+   while(used < length && read_ok == TRUE) {
+      bytes_read = read(reader->fd, bytes + used, length - used);
+
+      if(bytes_read > 0) {
+         used += (size_t) bytes_read;
+      }
+      else if(bytes_read == 0 || errno != EINTR) {
+         read_ok = FALSE;
+      }
+   }
+
+   if(lseek(reader->fd, resume_offset, SEEK_SET) == (off_t) -1) {
+      reader->read_error = TRUE;
+
+      return FALSE;
+   }
+
+   if(read_ok == FALSE) {
+      return FALSE;
+   }
+
+   *hash = hash_bytes(bytes, length, HASH_START);
+
+   return TRUE;
+}
+
+/*
+ * Return TRUE if file_name is no longer the file being read, such as when a
+ * new copy has been renamed over it or it has been deleted.
+ */
+Bool is_line_reader_replaced(Line_reader *reader, const char *file_name) {
+
+   struct stat file_status;
+   struct stat name_status;
+
+   if(fstat(reader->fd, &file_status) == -1) {
+      return FALSE;
+   }
+
+   if(stat(file_name, &name_status) == -1
+      || name_status.st_dev != file_status.st_dev
+      || name_status.st_ino != file_status.st_ino) {
+
+      return TRUE;
+   }
+
+   return FALSE;
+}
+
+/*
+ * Go back to the start of the file. Return FALSE if the file can't be
+ * rewound.
+ */
+Bool restart_line_reader(Line_reader *reader) {
+
+   if(lseek(reader->fd, 0, SEEK_SET) == (off_t) -1) {
+      return FALSE;
+   }
+
+   reset_stream_position(reader);
+
+   return TRUE;
+}
+
+/*
+ * Open file_name again and start reading it from the start, for when it has
+ * been replaced. Return FALSE, still reading the old file, if file_name
+ * can't be opened.
+ */
+Bool reopen_line_reader(Line_reader *reader, const char *file_name) {
+
+   int fd = open(file_name, O_RDONLY);
+
+   if(fd == -1) {
+      return FALSE;
+   }
+
+   (void) close(reader->fd);
+   reader->fd = fd;
+
+   reset_stream_position(reader);
+
+   return TRUE;
+}
+
+void reset_stream_position(Line_reader *reader) {
+
+   reader->offset = 0;
+   reader->position = 0;
+   reader->stream_end = 0;
+   reader->end_of_stream = FALSE;
+   reader->line_cut_short = FALSE;
+   reader->marked_offset = 0;
+}
+
+int open_stream_reader(Line_reader *reader, const char *file_name,
+   Bool standard_input) {
+
+   reader->type = STREAM_READER;
+
+   if(standard_input == TRUE) {
+      reader->fd = STDIN_FILENO;
+   }
+   else {
+      reader->fd = open(file_name, O_RDONLY);
+
+      if(reader->fd == -1) {
+         return FILE_ERROR;
+      }
+   }
+
+   reader->stream_buffer = budget_malloc(STREAM_BUFFER_SIZE);
+   reader->allocation_count++;
+
+   if(reader->stream_buffer == NULL) {
+      close_line_reader(reader);
+
+      return MEMORY_ERROR;
+   }
+
+   return 0;
+}
+
+/*
+ * Lines are handed out of the buffer until a line is found that runs past the
+ * end of the data read so far. That partial line is moved to the front of the
+ * buffer and the rest of the buffer is filled with another block.
+ */
+Bool get_next_stream_line(Line_reader *reader, const char **line,
+   size_t *line_length) {
+
+   const char *start;
+   const char *new_line;
+   size_t remaining;
+   ssize_t bytes_read;
+
+   reader->line_cut_short = FALSE;
+
+   for(;;) {
+      start = reader->stream_buffer + reader->position;
+      remaining = reader->stream_end - reader->position;
+
+      new_line = memchr(start, '\n', remaining);
+
+      if(new_line != NULL) {
+         *line = start;
+         *line_length = (size_t) (new_line - start);
+         reader->position += *line_length + 1;
+         reader->offset += *line_length + 1;
+
+         return TRUE;
+      }
+
+      /*
+       * The last line of the file doesn't have to end with a new line.
+       */
+      if(reader->end_of_stream == TRUE) {
+         if(remaining == 0) {
+            return FALSE;
+         }
+
+         *line = start;
+         *line_length = remaining;
+         reader->position = reader->stream_end;
+         reader->offset += remaining;
+
+         return TRUE;
+      }
+
+      if(reader->position > 0) {
+         (void) memmove(reader->stream_buffer, start, remaining);
+         reader->stream_end = remaining;
+         reader->position = 0;
+      }
+
+      /*
+       * A line that fills the whole buffer is far too long to be valid. Hand
+       * it out as it is and let the validator reject it.
+       */
+      if(reader->stream_end == STREAM_BUFFER_SIZE) {
+         *line = reader->stream_buffer;
+         *line_length = reader->stream_end;
+         reader->position = reader->stream_end;
+         reader->offset += reader->stream_end;
+         reader->line_cut_short = TRUE;
+
+         return TRUE;
+      }
+
+      bytes_read = read(reader->fd, reader->stream_buffer + reader->stream_end,
+         STREAM_BUFFER_SIZE - reader->stream_end);
+
+      if(bytes_read < 0) {
+         if(errno == EINTR) {
+            continue;
+         }
+
+         reader->read_error = TRUE;
+
+         return FALSE;
+      }
+
+      if(bytes_read == 0) {
+         if(reader->following == TRUE) {
+            return FALSE;
+         }
+
+         reader->end_of_stream = TRUE;
+      }
+
+      reader->stream_end += (size_t) bytes_read;
+   }
+}
+
+#else
+
+void follow_line_reader(Line_reader *reader) {
+
+   reader->following = TRUE;
+}
+
+Bool is_line_reader_rewritten(Line_reader *reader) {
+
+   (void) reader;
+
+   return FALSE;
+}
+
+void mark_line_reader_end(Line_reader *reader) {
+
+   (void) reader;
+}
+
+Bool is_line_reader_replaced(Line_reader *reader, const char *file_name) {
+
+   (void) reader;
+   (void) file_name;
+
+   return FALSE;
+}
+
+Bool restart_line_reader(Line_reader *reader) {
+
+   (void) reader;
+
+   return FALSE;
+}
+
+Bool reopen_line_reader(Line_reader *reader, const char *file_name) {
+
+   (void) reader;
+   (void) file_name;
+
+   return FALSE;
+}
+
+int open_stream_reader(Line_reader *reader, const char *file_name,
+   Bool standard_input) {
+
+   (void) reader;
+   (void) file_name;
+   (void) standard_input;
+
+   return FILE_ERROR;
+}
+
+Bool get_next_stream_line(Line_reader *reader, const char **line,
+   size_t *line_length) {
+
+   (void) reader;
+   (void) line;
+   (void) line_length;
+
+   return FALSE;
+}
+
+#endif
+
+Bool get_next_mapped_line(Line_reader *reader, const char **line,
+   size_t *line_length) {
+
+   const char *start;
+   const char *new_line;
+   size_t remaining;
+
+   if(reader->position >= reader->map.length) {
+      return FALSE;
+   }
+
+   start = reader->map.data + reader->position;
+   remaining = reader->map.length - reader->position;
+
+   new_line = memchr(start, '\n', remaining);
+
+   /*
+    * The last line of the file doesn't have to end with a new line.
+    */
+   if(new_line == NULL) {
+      *line_length = remaining;
+      reader->position = reader->map.length;
+   }
+   else {
+      *line_length = (size_t) (new_line - start);
+      reader->position += *line_length + 1;
+   }
+
+   *line = start;
+   reader->offset = reader->position;
+
+   return TRUE;
+}
+
+/*
+ * Lines longer than the buffer are split up by fgets. The first piece is
+ * already too long to be a valid line, so the validator will reject it before
+ * the rest of the line is ever read.
+ */
+Bool get_next_stdio_line(Line_reader *reader, const char **line,
+   size_t *line_length) {
+
+   if(fgets(reader->line_buffer, LINE_BUFFER_SIZE - 1, reader->fp) == NULL) {
+      if(ferror(reader->fp)) {
+         reader->read_error = TRUE;
+      }
+
+      return FALSE;
+   }
+
+   *line_length = strlen(reader->line_buffer);
+   reader->offset += *line_length;
+   reader->line_cut_short = FALSE;
+
+   if(*line_length > 0 && reader->line_buffer[*line_length - 1] == '\n') {
+      (*line_length)--;
+   }
+   else if(feof(reader->fp) == 0) {
+      reader->line_cut_short = TRUE;
+   }
+
+   *line = reader->line_buffer;
+
+   return TRUE;
+}
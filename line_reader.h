@@ -0,0 +1,101 @@
+/*
+ * Name:       line_reader.h
+ *
+ * Purpose:    Macros, typedef and function definitions for line_reader.c.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#ifndef LINE_READER_H
+
+#define LINE_READER_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include "boolean.h"
+#include "integer_types.h"
+#include "size_limits.h"
+#include "file_map.h"
+
+/*
+ * Passing this as the file name reads the budget data from standard input.
+ */
+#define STANDARD_INPUT_FILE_NAME "-"
+
+/*
+ * How a line reader gets its data.
+ */
+#define STDIO_READER 0
+#define MAPPED_READER 1
+#define STREAM_READER 2
+#define MEMORY_READER 3
+
+/*
+ * Size of the block read at a time from a pipe or other file that can't be
+ * mapped.
+ */
+#define STREAM_BUFFER_SIZE (1024 * 1024)
+
+/*
+ * Number of bytes just before where a followed file was read up to that are
+ * checked for changes each time it changes.
+ */
+#define FOLLOW_CHECK_SPAN 4096
+
+/*
+ * offset is the number of bytes handed out so far, new line characters
+ * included, so after the last line it is the size of the input.
+ *
+ * following is set by follow_line_reader (see line_reader.c).
+ *
+ * line_cut_short is TRUE if the last line handed out was only the start of a
+ * line too long for the buffer.
+ *
+ * marked_offset and marked_hash are set by mark_line_reader_end, for a file
+ * being followed.
+ *
+ * allocation_count is the number of allocations made to open the reader,
+ * which is 1 for a file read in blocks and 0 otherwise.
+ */
+typedef struct {
+   int type;
+   Bool read_error;
+   Bool following;
+   Bool line_cut_short;
+   Uint64 offset;
+   FILE *fp;
+   File_map map;
+   size_t position;
+   int fd;
+   char *stream_buffer;
+   size_t stream_end;
+   Bool end_of_stream;
+   Uint64 marked_offset;
+   Uint64 marked_hash;
+   unsigned long allocation_count;
+   char line_buffer[LINE_BUFFER_SIZE];
+} Line_reader;
+
+int open_line_reader(Line_reader *reader, const char *file_name,
+   Bool allow_mapping);
+void open_memory_line_reader(Line_reader *reader, const char *data,
+   size_t length);
+Bool get_next_line(Line_reader *reader, const char **line,
+   size_t *line_length);
+void skip_rest_of_line(Line_reader *reader);
+void close_line_reader(Line_reader *reader);
+void follow_line_reader(Line_reader *reader);
+Bool is_line_reader_rewritten(Line_reader *reader);
+void mark_line_reader_end(Line_reader *reader);
+Bool is_line_reader_replaced(Line_reader *reader, const char *file_name);
+Bool restart_line_reader(Line_reader *reader);
+Bool reopen_line_reader(Line_reader *reader, const char *file_name);
+
+#endif
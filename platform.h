@@ -0,0 +1,35 @@
+/*
+ * Name:       platform.h
+ *
+ * Purpose:    Macro for detecting whether c_budget is being built on a
+ *             platform with POSIX system calls (Linux, macOS, BSD, etc.).
+ *
+ *             c_budget itself only needs C89. Faster ways of reading the
+ *             budget data, such as memory-mapping the file, are only compiled
+ *             in when POSIX_PLATFORM is defined. Everywhere else c_budget
+ *             falls back to plain stdio.
+ *
+ *             Source files which use POSIX system calls must define
+ *             _POSIX_C_SOURCE before including any headers, because -ansi
+ *             hides the POSIX declarations otherwise.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#ifndef PLATFORM_H
+
+#define PLATFORM_H
+
+#if defined(__unix__) || defined(__unix) \
+   || (defined(__APPLE__) && defined(__MACH__))
+#define POSIX_PLATFORM
+#endif
+
+#endif
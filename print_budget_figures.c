@@ -1,111 +1,566 @@
-/*
- * Name:       print_budget_figures.h
- *
- * Purpose:    Function for displaying the budget figures in tables to stdout.
- *
- * Author:     jjones4
- *
- * Copyright (c) 2024 Jerad Jones
- *
- * This file is part of c_budget. c_budget may be freely distributed under the
- * MIT license. For all details and documentation, see:
- *
- *             https://github.com/jjones4/c_budget
- */
-
-#include <stdio.h>
-#include "size_limits.h"
-#include "print_budget_figures.h"
-
-void display_yearly_figures(double *yearly_credits, double *yearly_debits,
-   double *yearly_margins);
-void display_large_transactions(double *large_amounts_credits, double
-   *large_amounts_debits, double *large_amounts_margins);
-void display_monthly_figures(double *monthly_credits, double *monthly_debits,
-   double *monthly_margins);
-
-void display_budget_figures(double *monthly_credits, double *monthly_debits,
-   double *monthly_margins, double *large_amounts_credits, double
-   *large_amounts_debits, double *large_amounts_margins, double
-   *yearly_credits, double *yearly_debits, double *yearly_margins) {
-
-   display_yearly_figures(yearly_credits, yearly_debits, yearly_margins);
-   display_large_transactions(large_amounts_credits, large_amounts_debits,
-      large_amounts_margins);
-   display_monthly_figures(monthly_credits, monthly_debits, monthly_margins);
-}
-
-void display_yearly_figures(double *yearly_credits, double *yearly_debits,
-   double *yearly_margins) {
-
-   int i;
-
-   printf("\n   YEARLY TOTALS\n\n");
-
-   for(i = 0; i < NUMBER_OF_YEARS; i++) {
-      if(yearly_credits[i] != 0.00 || yearly_debits[i] != 0.00) {
-         printf("%6s%-10s%10d%18.2f%18.2f%18.2f\n", "", "",
-            START_YEAR + i, yearly_credits[i], yearly_debits[i],
-            yearly_margins[i]);
-      }
-   }
-
-   printf("\n   AVERAGE MONTHLY FIGURES FOR EACH YEAR\n\n");
-
-   for(i = 0; i < NUMBER_OF_YEARS; i++) {
-      if(yearly_credits[i] != 0.00 || yearly_debits[i] != 0.00) {
-         printf("%6s%-10s%10d%18.2f%18.2f%18.2f\n", "", "",
-            START_YEAR + i, yearly_credits[i] / 12, yearly_debits[i] / 12,
-            yearly_margins[i] / 12);
-      }
-   }
-}
-
-void display_large_transactions(double *large_amounts_credits, double
-   *large_amounts_debits, double *large_amounts_margins) {
-
-   int i;
-
-   const char* month_names[] = { "January", "February", "March", "April",
-      "May", "June", "July", "August", "September", "October", "November",
-      "December"};
-
-   printf("\n   LARGE TRANSACTIONS\n\n");
-
-   for(i = 0; i < NUMBER_OF_MONTHS; i++) {
-      if(large_amounts_credits[i] != 0.00 || large_amounts_debits[i] != 0.00) {
-         printf("%6s%-10s%10d%18.2f%18.2f%18.2f\n",
-           "", month_names[i % 12], ((i - (i % 12)) / 12) + START_YEAR,
-           large_amounts_credits[i], large_amounts_debits[i],
-           large_amounts_margins[i]);
-      }
-   }
-}
-
-void display_monthly_figures(double *monthly_credits, double *monthly_debits,
-   double *monthly_margins) {
-
-   int i;
-
-   const char* month_names[] = { "January", "February", "March", "April",
-      "May", "June", "July", "August", "September", "October", "November",
-      "December"};
-
-   printf("\n   MONTHLY TRANSACTIONS\n\n");
-
-   for(i = 0; i < NUMBER_OF_MONTHS; i++) {
-      if(monthly_credits[i] != 0.00 || monthly_debits[i] != 0.00) {
-         printf("%6s%-10s%10d%18.2f%18.2f%18.2f\n",
-           "", month_names[i % 12], ((i - (i % 12)) / 12) + START_YEAR,
-           monthly_credits[i], monthly_debits[i],
-           monthly_margins[i]);
-      }
-   }
-
-   /*
-    * For when the program is run on my Linux computer (needs an extra new line
-    * so there is an extra line between the output of the program and the next
-    * terminal prompt.
-    */
-   printf("\n");
-}
\ No newline at end of file
+/*
+ * Name:       print_budget_figures.h
+ *
+ * Purpose:    Function for displaying the budget figures in tables to stdout
+ *             or to a file.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "budget_memory.h"
+#include "print_budget_figures.h"
+#include "date_ranges.h"
+#include "rolling_windows.h"
+#include "report_writer.h"
+#include "export_budget_figures.h"
+
+/*
+ * A category to be printed, for sorting the categories by name.
+ */
+typedef struct {
+   const char *name;
+   size_t name_length;
+   const Category_figures *figures;
+} Category_row;
+
+void print_figures_row(Report_writer *writer, const char *month_name,
+   int year, Cents credits, Cents debits, Cents margins);
+
+void display_yearly_figures(Report_writer *writer, const Ledger *ledger);
+void display_large_transactions(Report_writer *writer, const Ledger *ledger);
+void display_monthly_figures(Report_writer *writer, const Ledger *ledger);
+void display_category_figures(Report_writer *writer, const Ledger *ledger);
+void display_debit_quantiles(Report_writer *writer, const Ledger *ledger);
+void display_band_figures(Report_writer *writer, const Ledger *ledger);
+void display_date_range_figures(Report_writer *writer, const Ledger *ledger,
+   const Program_options *options);
+void display_top_transactions(Report_writer *writer, const char *title,
+   const Top_heap *heap);
+void display_rolling_windows(Report_writer *writer, const Ledger *ledger);
+int compare_category_rows(const void *first, const void *second);
+
+/*
+ * Only the years and months between the earliest and latest transaction are
+ * gone through, and empty ones are skipped as always. The whole report is
+ * put together in memory and written out at the end (see report_writer.c),
+ * to standard output or to the file given with -o. With --format, the
+ * figures are written for other programs instead (see
+ * export_budget_figures.c).
+ *
+ * Return 0 if successful. Return FILE_ERROR if the report could not be
+ * written.
+ */
+int display_budget_figures(const Ledger *ledger,
+   const Program_options *options) {
+
+   Report_writer writer;
+
+   open_report_writer(&writer, options->output_file_name);
+
+   if(options->output_format != TABLE_FORMAT) {
+      export_budget_figures(&writer, ledger, options->output_format);
+
+      return close_report_writer(&writer);
+   }
+
+   display_yearly_figures(&writer, ledger);
+   display_large_transactions(&writer, ledger);
+   display_monthly_figures(&writer, ledger);
+
+   if(ledger->options.band_count > 0) {
+      display_band_figures(&writer, ledger);
+   }
+
+   if(ledger->options.quantiles == TRUE) {
+      display_debit_quantiles(&writer, ledger);
+   }
+
+   if(ledger->options.categories == TRUE) {
+      display_category_figures(&writer, ledger);
+   }
+
+   if(options->date_range_count > 0) {
+      display_date_range_figures(&writer, ledger, options);
+   }
+
+   if(options->rolling == TRUE) {
+      display_rolling_windows(&writer, ledger);
+   }
+
+   if(ledger->options.top_count > 0) {
+      display_top_transactions(&writer, "LARGEST CREDITS",
+         &ledger->top.credits);
+      display_top_transactions(&writer, "LARGEST DEBITS",
+         &ledger->top.debits);
+   }
+
+   /*
+    * For when the program is run on my Linux computer (needs an extra new line
+    * so there is an extra line between the output of the program and the next
+    * terminal prompt.
+    */
+   write_report_text(&writer, "\n");
+
+   return close_report_writer(&writer);
+}
+
+void display_yearly_figures(Report_writer *writer, const Ledger *ledger) {
+
+   int year;
+   int first_year = ledger->first_used_month / 12;
+   int last_year = ledger->last_used_month / 12;
+   Month_figures year_figures;
+
+   if(ledger->used == FALSE) {
+      last_year = first_year - 1;
+   }
+
+   write_report_text(writer, "\n   YEARLY TOTALS\n\n");
+
+   for(year = first_year; year <= last_year; year++) {
+      get_year_figures(ledger, year, &year_figures);
+
+      if(year_figures.credits != 0 || year_figures.debits != 0) {
+         print_figures_row(writer, "", year, year_figures.credits,
+            year_figures.debits, year_figures.credits + year_figures.debits);
+      }
+   }
+
+   write_report_text(writer, "\n   AVERAGE MONTHLY FIGURES FOR EACH YEAR\n\n");
+
+   for(year = first_year; year <= last_year; year++) {
+      get_year_figures(ledger, year, &year_figures);
+
+      if(year_figures.credits != 0 || year_figures.debits != 0) {
+         print_figures_row(writer, "", year,
+            divide_cents(year_figures.credits, 12),
+            divide_cents(year_figures.debits, 12),
+            divide_cents(year_figures.credits + year_figures.debits, 12));
+      }
+   }
+}
+
+void display_large_transactions(Report_writer *writer, const Ledger *ledger) {
+
+   int i;
+   int first_month = ledger->first_used_month;
+   int last_month = ledger->last_used_month;
+   const Month_figures *month_figures;
+
+   const char* month_names[] = { "January", "February", "March", "April",
+      "May", "June", "July", "August", "September", "October", "November",
+      "December"};
+
+   if(ledger->used == FALSE) {
+      last_month = first_month - 1;
+   }
+
+   write_report_text(writer, "\n   LARGE TRANSACTIONS\n\n");
+
+   for(i = first_month; i <= last_month; i++) {
+      month_figures = &ledger->months[i - ledger->first_month];
+
+      if(month_figures->large_credits != 0
+         || month_figures->large_debits != 0) {
+
+         print_figures_row(writer, month_names[i % 12], i / 12,
+           month_figures->large_credits, month_figures->large_debits,
+           month_figures->large_credits + month_figures->large_debits);
+      }
+   }
+}
+
+void display_monthly_figures(Report_writer *writer, const Ledger *ledger) {
+
+   int i;
+   int first_month = ledger->first_used_month;
+   int last_month = ledger->last_used_month;
+   const Month_figures *month_figures;
+
+   const char* month_names[] = { "January", "February", "March", "April",
+      "May", "June", "July", "August", "September", "October", "November",
+      "December"};
+
+   if(ledger->used == FALSE) {
+      last_month = first_month - 1;
+   }
+
+   write_report_text(writer, "\n   MONTHLY TRANSACTIONS\n\n");
+
+   for(i = first_month; i <= last_month; i++) {
+      month_figures = &ledger->months[i - ledger->first_month];
+
+      if(month_figures->credits != 0 || month_figures->debits != 0) {
+         print_figures_row(writer, month_names[i % 12], i / 12,
+           month_figures->credits, month_figures->debits,
+           month_figures->credits + month_figures->debits);
+      }
+   }
+}
+
+/*
+ * Print the monthly totals of each amount band, one table per band.
+ */
+void display_band_figures(Report_writer *writer, const Ledger *ledger) {
+
+   int band;
+   int i;
+   int first_month = ledger->first_used_month;
+   int last_month = ledger->last_used_month;
+   const Cents *cutoffs = ledger->options.band_cutoffs;
+   Cents amount;
+   char low_string[CENTS_STRING_LENGTH];
+   char high_string[CENTS_STRING_LENGTH];
+
+   const char* month_names[] = { "January", "February", "March", "April",
+      "May", "June", "July", "August", "September", "October", "November",
+      "December"};
+
+   if(ledger->used == FALSE) {
+      last_month = first_month - 1;
+   }
+
+   for(band = 0; band < ledger->options.band_count; band++) {
+      if(band > 0) {
+         format_cents(cutoffs[band - 1], low_string);
+      }
+
+      if(band < ledger->options.band_count - 1) {
+         format_cents(cutoffs[band], high_string);
+      }
+
+      if(band == 0) {
+         write_report_text(writer, "\n   AMOUNTS BELOW ");
+         write_report_text(writer, high_string);
+      }
+      else if(band == ledger->options.band_count - 1) {
+         write_report_text(writer, "\n   AMOUNTS OF ");
+         write_report_text(writer, low_string);
+         write_report_text(writer, " AND ABOVE");
+      }
+      else {
+         write_report_text(writer, "\n   AMOUNTS FROM ");
+         write_report_text(writer, low_string);
+         write_report_text(writer, " UP TO ");
+         write_report_text(writer, high_string);
+      }
+
+      write_report_text(writer, "\n\n");
+
+      for(i = first_month; i <= last_month; i++) {
+         amount = get_band_amounts(ledger, i)[band];
+
+         if(amount != 0) {
+            write_report_field(writer, "", 0, 6);
+            write_report_field(writer, month_names[i % 12],
+               strlen(month_names[i % 12]), -10);
+            write_report_number(writer, i / 12, 10);
+            write_report_cents(writer, amount, 18);
+            write_report_text(writer, "\n");
+         }
+      }
+   }
+}
+
+/*
+ * Print the median, 90th percentile and 99th percentile debit for each year
+ * and month, as positive amounts, in place of the credits, debits and
+ * margins.
+ */
+void display_debit_quantiles(Report_writer *writer, const Ledger *ledger) {
+
+   int i;
+   int first_month = ledger->first_used_month;
+   int last_month = ledger->last_used_month;
+   Quantile_sketch year_sketch;
+   const Quantile_sketch *sketch;
+
+   const char* month_names[] = { "January", "February", "March", "April",
+      "May", "June", "July", "August", "September", "October", "November",
+      "December"};
+
+   if(ledger->used == FALSE) {
+      last_month = first_month - 1;
+   }
+
+   write_report_text(writer, "\n   DEBIT SIZES FOR EACH YEAR (MEDIAN, 90TH");
+   write_report_text(writer, " AND 99TH PERCENTILES)\n\n");
+
+   for(i = first_month / 12; i <= last_month / 12; i++) {
+      get_year_sketch(ledger, i, &year_sketch);
+
+      if(year_sketch.count > 0) {
+         print_figures_row(writer, "", i, get_quantile(&year_sketch, 50),
+            get_quantile(&year_sketch, 90), get_quantile(&year_sketch, 99));
+      }
+   }
+
+   write_report_text(writer, "\n   DEBIT SIZES FOR EACH MONTH (MEDIAN, 90TH");
+   write_report_text(writer, " AND 99TH PERCENTILES)\n\n");
+
+   for(i = first_month; i <= last_month; i++) {
+      sketch = ledger->sketches[i - ledger->first_month];
+
+      if(sketch != NULL) {
+         print_figures_row(writer, month_names[i % 12], i / 12,
+            get_quantile(sketch, 50), get_quantile(sketch, 90),
+            get_quantile(sketch, 99));
+      }
+   }
+}
+
+/*
+ * Print the figures for each category, sorted by name. If there isn't
+ * enough memory to sort them, they are printed in the order they were first
+ * seen instead.
+ */
+void display_category_figures(Report_writer *writer, const Ledger *ledger) {
+
+   const Category_table *categories = &ledger->categories;
+   size_t category_count = categories->names.entry_count;
+   Category_row *rows = NULL;
+   Category_row row;
+   size_t i;
+
+   write_report_text(writer, "\n   CATEGORY TOTALS\n\n");
+
+   if(category_count > 0) {
+      rows = budget_malloc(category_count * sizeof(Category_row));
+   }
+
+   for(i = 0; i < category_count && rows != NULL; i++) {
+      rows[i].name = get_string(&categories->names, (Uint32) i,
+         &rows[i].name_length);
+      rows[i].figures = &categories->figures[i];
+   }
+
+   if(rows != NULL) {
+      qsort(rows, category_count, sizeof(Category_row),
+         compare_category_rows);
+   }
+
+   for(i = 0; i < category_count; i++) {
+      if(rows != NULL) {
+         row = rows[i];
+      }
+      else {
+         row.name = get_string(&categories->names, (Uint32) i,
+            &row.name_length);
+         row.figures = &categories->figures[i];
+      }
+
+      if(row.name_length == 0) {
+         row.name = "(none)";
+         row.name_length = strlen(row.name);
+      }
+
+      write_report_field(writer, "", 0, 6);
+      write_report_field(writer, row.name, row.name_length, -20);
+      write_report_cents(writer, row.figures->credits, 18);
+      write_report_cents(writer, row.figures->debits, 18);
+      write_report_cents(writer, row.figures->credits + row.figures->debits,
+         18);
+      write_report_text(writer, "\n");
+   }
+
+   budget_free(rows);
+}
+
+/*
+ * Print the figures for each date range, in the order they were given. A
+ * range without a first or last date is shown with that date left blank.
+ */
+void display_date_range_figures(Report_writer *writer, const Ledger *ledger,
+   const Program_options *options) {
+
+   Range_totals totals;
+   Day_figures figures;
+   const Date_range *range;
+   char first_date[DATE_STRING_LENGTH];
+   char last_date[DATE_STRING_LENGTH];
+   int i;
+
+   build_range_totals(ledger, &totals);
+
+   write_report_text(writer, "\n   DATE RANGE TOTALS\n\n");
+
+   for(i = 0; i < options->date_range_count; i++) {
+      range = &options->date_ranges[i];
+
+      get_range_figures(&totals, range, &figures);
+
+      first_date[0] = '\0';
+      last_date[0] = '\0';
+
+      if(range->has_first_day == TRUE) {
+         format_day_number(range->first_day, first_date);
+      }
+
+      if(range->has_last_day == TRUE) {
+         format_day_number(range->last_day, last_date);
+      }
+
+      write_report_field(writer, "", 0, 6);
+      write_report_field(writer, first_date, strlen(first_date), 10);
+      write_report_text(writer, " - ");
+      write_report_field(writer, last_date, strlen(last_date), -10);
+      write_report_cents(writer, figures.credits, 18);
+      write_report_cents(writer, figures.debits, 18);
+      write_report_cents(writer, figures.credits + figures.debits, 18);
+      write_report_text(writer, "\n");
+   }
+
+   free_range_totals(&totals);
+}
+
+/*
+ * Print the net margins over the most recent days, and the lowest they have
+ * been over the same number of days, with the last day of each window. If
+ * the data covers fewer days than a window, it has no worst.
+ */
+void display_rolling_windows(Report_writer *writer, const Ledger *ledger) {
+
+   Rolling_window windows[ROLLING_WINDOW_COUNT];
+   char date_string[DATE_STRING_LENGTH];
+   int i;
+
+   if(ledger->used == TRUE) {
+      get_rolling_windows(ledger, windows);
+   }
+
+   write_report_text(writer, "\n   LATEST ROLLING NET MARGINS\n\n");
+
+   for(i = 0; i < ROLLING_WINDOW_COUNT && ledger->used == TRUE; i++) {
+      format_day_number(windows[i].latest_last_day, date_string);
+
+      write_report_field(writer, "", 0, 6);
+      write_report_number(writer, windows[i].length, 3);
+      write_report_text(writer, " days to ");
+      write_report_field(writer, date_string, strlen(date_string), -10);
+      write_report_cents(writer, windows[i].latest_margins, 18);
+      write_report_text(writer, "\n");
+   }
+
+   write_report_text(writer, "\n   WORST ROLLING NET MARGINS\n\n");
+
+   for(i = 0; i < ROLLING_WINDOW_COUNT && ledger->used == TRUE; i++) {
+      write_report_field(writer, "", 0, 6);
+      write_report_number(writer, windows[i].length, 3);
+
+      if(windows[i].has_worst == FALSE) {
+         write_report_text(writer, " days: the data covers too few days for");
+         write_report_text(writer, " a full window\n");
+         continue;
+      }
+
+      format_day_number(windows[i].worst_last_day, date_string);
+
+      write_report_text(writer, " days to ");
+      write_report_field(writer, date_string, strlen(date_string), -10);
+      write_report_cents(writer, windows[i].worst_margins, 18);
+      write_report_text(writer, "\n");
+   }
+}
+
+/*
+ * Print the transactions in heap from the largest to the smallest. If there
+ * isn't enough memory to sort them, they are printed in the order the heap
+ * has them in instead.
+ */
+void display_top_transactions(Report_writer *writer, const char *title,
+   const Top_heap *heap) {
+
+   Top_transaction *rows = NULL;
+   const Top_transaction *row;
+   char date_string[DATE_STRING_LENGTH];
+   int i;
+
+   write_report_text(writer, "\n   ");
+   write_report_text(writer, title);
+   write_report_text(writer, "\n\n");
+
+   if(heap->count > 0) {
+      rows = budget_malloc(heap->count * sizeof(Top_transaction));
+   }
+
+   if(rows != NULL) {
+      (void) memcpy(rows, heap->transactions,
+         heap->count * sizeof(Top_transaction));
+      qsort(rows, heap->count, sizeof(Top_transaction),
+         compare_top_transactions);
+   }
+
+   for(i = 0; i < heap->count; i++) {
+      row = rows != NULL ? &rows[i] : &heap->transactions[i];
+
+      format_day_number(row->day_number, date_string);
+
+      write_report_field(writer, "", 0, 6);
+      write_report_field(writer, date_string, strlen(date_string), -20);
+      write_report_cents(writer, row->amount, 18);
+      write_report_field(writer, "", 0, 3);
+      write_report_field(writer, row->description,
+         (size_t) row->description_length, 0);
+      write_report_text(writer, "\n");
+   }
+
+   budget_free(rows);
+}
+
+/*
+ * Order categories by the bytes of their names, with a name coming before
+ * any longer name it is the start of.
+ */
+int compare_category_rows(const void *first, const void *second) {
+
+   const Category_row *first_row = first;
+   const Category_row *second_row = second;
+   size_t length = first_row->name_length;
+   int result;
+
+   if(second_row->name_length < length) {
+      length = second_row->name_length;
+   }
+
+   result = memcmp(first_row->name, second_row->name, length);
+
+   if(result != 0) {
+      return result;
+   }
+
+   if(first_row->name_length < second_row->name_length) {
+      return -1;
+   }
+
+   if(first_row->name_length > second_row->name_length) {
+      return 1;
+   }
+
+   return 0;
+}
+
+/*
+ * Print one row of a table. The amounts are only turned into decimal digits
+ * here, at the very end, straight into the report.
+ */
+void print_figures_row(Report_writer *writer, const char *month_name,
+   int year, Cents credits, Cents debits, Cents margins) {
+
+   write_report_field(writer, "", 0, 6);
+   write_report_field(writer, month_name, strlen(month_name), -10);
+   write_report_number(writer, year, 10);
+   write_report_cents(writer, credits, 18);
+   write_report_cents(writer, debits, 18);
+   write_report_cents(writer, margins, 18);
+   write_report_text(writer, "\n");
+}
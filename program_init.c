@@ -1,154 +1,569 @@
-/*
- * Name:       program_init.c
- *
- * Purpose:    Perform initial checks and initialization to get required data
- *             from data file and set up the program's data structure for the
- *             budget.
- *
- * Author:     jjones4
- *
- * Copyright (c) 2024 Jerad Jones
- *
- * This file is part of c_budget. c_budget may be freely distributed under the
- * MIT license. For all details and documentation, see:
- *
- *             https://github.com/jjones4/c_budget
- */
-
-#include <stdlib.h>
-#include <string.h>
-#include "program_init.h"
-#include "return_codes.h"
-
-Bool arg_count_within_range(int argument_count);
-Bool string_length_within_range(const char *s, int maximum_string_length);
-Bool is_default_data_file_used(int argument_count);
-Bool is_valid_data_file_name_length(Bool default_data_file_used,
-   char **arg_vector);
-void get_data_file_name(Bool default_data_file_used, char *default_data_file,
-   char **arg_vector);
-
-/*
- * Return 0 to main function if all initializations and checks succeed. Return
- * applicable error code, otherwise (see return_codes.h).
- */
-int program_init(int argument_count, char **argument_vector,
-   char **data_file_name) {
-
-   char *data_file = NULL;
-
-   /*
-    * Ensure number of command-line arguments given does not exceed maximum
-    * number of allowable arguments.
-    */
-   if(arg_count_within_range(argument_count) == FALSE) {
-      printf("\nUp to one argument allowed after program name.\n");
-
-      return ARGUMENT_ERROR;
-   }
-
-   data_file = malloc(FILE_NAME_LENGTH + 1);
-
-   if(data_file == NULL) {
-      printf("\nMemory could not be allocated.\n");
-
-      return MEMORY_ERROR;
-   }
-
-   /*
-    * Make sure the data file name length is within the valid range. Based on
-    * the number of command-line arguments provided, it is determined whether
-    * the user is entering a name for the data file or is using the default
-    * data file.
-    */
-   if(is_valid_data_file_name_length(is_default_data_file_used(argument_count),
-      argument_vector) == FALSE) {
-
-      printf("\nData file name exceeds maximum number of %d",
-            FILE_NAME_LENGTH);
-      printf(" allowable characters.\n");
-
-      return FILE_ERROR;
-   }
-
-   /*
-    * If get_data_file_name is successful, data_file will point to the data
-    * file name, which can be used to open the file later. Based on the number
-    * of command-line arguments provided, it is determined whether the user is
-    * entering a name for the data file or is using the default data file.
-    */
-   (void) get_data_file_name(is_default_data_file_used(argument_count), data_file,
-      argument_vector);
-
-   (void) strncpy(*data_file_name, data_file, FILE_NAME_LENGTH - 1);
-
-   free(data_file);
-
-   return 0;
-}
-
-Bool is_default_data_file_used(int argument_count) {
-   if(argument_count > 1) {
-      return FALSE;
-   }
-   else {
-      return TRUE;
-   }
-}
-
-Bool arg_count_within_range(int argument_count) {
-   if(argument_count > MAX_ARG_COUNT || argument_count < MIN_ARG_COUNT) {
-      return FALSE;
-   }
-   else {
-      return TRUE;
-   }
-}
-
-Bool string_length_within_range(const char *s, int maximum_string_length)
-{
-   int i = 0;
-
-   while(*s) {
-      s++;
-      i++;
-
-      if(i > maximum_string_length) {
-         return FALSE;
-      }
-   }
-
-   return TRUE;
-}
-
-Bool is_valid_data_file_name_length(Bool default_data_file_used,
-   char **arg_vector) {
-
-   if(default_data_file_used == TRUE) {
-      if(!string_length_within_range(DEFAULT_DATA_FILE, FILE_NAME_LENGTH)) {
-
-         return FALSE;
-      }
-   }
-   else {
-      if(!string_length_within_range(*++arg_vector, FILE_NAME_LENGTH)) {
-
-         return FALSE;
-      }
-   }
-
-   return TRUE;
-}
-
-void get_data_file_name(Bool default_data_file_used, char *data_file_name,
-   char **arg_vector) {
-   
-   if(default_data_file_used == TRUE) {
-
-      (void) strncpy(data_file_name, DEFAULT_DATA_FILE, FILE_NAME_LENGTH -1);
-   }
-   else {
-      
-      (void) strncpy(data_file_name, *++arg_vector, FILE_NAME_LENGTH - 1);
-   }
-}
+/*
+ * Name:       program_init.c
+ *
+ * Purpose:    Perform initial checks and initialization to get required data
+ *             from data file and set up the program's data structure for the
+ *             budget.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "platform.h"
+#include "program_init.h"
+#include "return_codes.h"
+#include "line_reader.h"
+#include "simd_scan.h"
+#include "validate_budget_line.h"
+#include "budget_files.h"
+
+Bool string_length_within_range(const char *s, int maximum_string_length);
+Bool is_option(const char *argument);
+Bool get_number_argument(const char *argument, int minimum, int maximum,
+   int *number);
+Bool get_date_argument(const char *argument, int *day_number);
+Bool get_bands_argument(const char *argument, Ledger_options *options);
+Bool get_format_argument(const char *argument, int *format);
+int add_date_range_argument(Program_options *options, const char *option,
+   const char *argument);
+
+/*
+ * Fill in options from the command-line arguments. Any argument that isn't an
+ * option is the name of a budget data file, a directory of them or a pattern
+ * matching them. If no file name is given, the default data file is used.
+ *
+ * Return 0 to main function if all initializations and checks succeed. Return
+ * applicable error code, otherwise (see return_codes.h).
+ */
+int program_init(int argument_count, char **argument_vector,
+   Program_options *options) {
+
+   int i;
+
+   select_simd_scan();
+
+   (void) strcpy(options->data_file_name, DEFAULT_DATA_FILE);
+   options->data_file_arguments = argument_vector + 1;
+   options->data_file_count = 0;
+   options->multiple_files = FALSE;
+   options->thread_count = 1;
+   options->allow_mapping = TRUE;
+   options->use_cache = FALSE;
+   options->incremental = FALSE;
+   options->follow = FALSE;
+   options->ledger_options.categories = FALSE;
+   options->ledger_options.normalize_categories = FALSE;
+   options->ledger_options.days = FALSE;
+   options->ledger_options.top_count = 0;
+   options->ledger_options.quantiles = FALSE;
+   options->ledger_options.band_count = 0;
+   options->date_range_count = 0;
+   options->rolling = FALSE;
+   options->output_file_name = NULL;
+   options->output_format = TABLE_FORMAT;
+   options->all_errors = FALSE;
+   options->check_only = FALSE;
+
+   for(i = 1; i < argument_count; i++) {
+      if(strcmp(argument_vector[i], THREAD_COUNT_OPTION) == 0) {
+         if(++i == argument_count || get_number_argument(argument_vector[i],
+            1, MAX_THREAD_COUNT, &options->thread_count) == FALSE) {
+
+            printf("\n%s must be followed by a number of threads from 1 to",
+               THREAD_COUNT_OPTION);
+            printf(" %d.\n", MAX_THREAD_COUNT);
+
+            return ARGUMENT_ERROR;
+         }
+
+         continue;
+      }
+
+      if(strcmp(argument_vector[i], OUTPUT_OPTION) == 0) {
+         if(++i == argument_count) {
+            printf("\n%s must be followed by the name of a file to write the",
+               OUTPUT_OPTION);
+            printf(" budget figures to.\n");
+
+            return ARGUMENT_ERROR;
+         }
+
+         options->output_file_name = argument_vector[i];
+
+         continue;
+      }
+
+      if(strcmp(argument_vector[i], FORMAT_OPTION) == 0) {
+         if(++i == argument_count || get_format_argument(argument_vector[i],
+            &options->output_format) == FALSE) {
+
+            printf("\n%s must be followed by table, csv, jsonl or bin.\n",
+               FORMAT_OPTION);
+
+            return ARGUMENT_ERROR;
+         }
+
+         continue;
+      }
+
+      if(strcmp(argument_vector[i], ALL_ERRORS_OPTION) == 0) {
+         options->all_errors = TRUE;
+
+         continue;
+      }
+
+      if(strcmp(argument_vector[i], CHECK_OPTION) == 0) {
+         options->check_only = TRUE;
+
+         continue;
+      }
+
+      if(strcmp(argument_vector[i], STREAM_OPTION) == 0) {
+         options->allow_mapping = FALSE;
+
+         continue;
+      }
+
+      if(strcmp(argument_vector[i], CACHE_OPTION) == 0) {
+         options->use_cache = TRUE;
+
+         continue;
+      }
+
+      if(strcmp(argument_vector[i], INCREMENTAL_OPTION) == 0) {
+         options->incremental = TRUE;
+
+         continue;
+      }
+
+      if(strcmp(argument_vector[i], FOLLOW_OPTION) == 0) {
+         options->follow = TRUE;
+
+         continue;
+      }
+
+      if(strcmp(argument_vector[i], TOP_OPTION) == 0) {
+         if(++i == argument_count || get_number_argument(argument_vector[i],
+            1, MAX_TOP_COUNT, &options->ledger_options.top_count) == FALSE) {
+
+            printf("\n%s must be followed by a number of transactions from",
+               TOP_OPTION);
+            printf(" 1 to %d.\n", MAX_TOP_COUNT);
+
+            return ARGUMENT_ERROR;
+         }
+
+         continue;
+      }
+
+      if(strcmp(argument_vector[i], QUANTILES_OPTION) == 0) {
+         options->ledger_options.quantiles = TRUE;
+
+         continue;
+      }
+
+      if(strcmp(argument_vector[i], BANDS_OPTION) == 0) {
+         if(++i == argument_count || get_bands_argument(argument_vector[i],
+            &options->ledger_options) == FALSE) {
+
+            printf("\n%s must be followed by up to %d amounts from lowest to",
+               BANDS_OPTION, MAX_AMOUNT_BANDS - 1);
+            printf(" highest, separated by commas, such as");
+            printf(" -2400.00,-500.00,0.00,3000.00.\n");
+
+            return ARGUMENT_ERROR;
+         }
+
+         continue;
+      }
+
+      /*
+       * Rolling windows are added up from the figures for each day.
+       */
+      if(strcmp(argument_vector[i], ROLLING_OPTION) == 0) {
+         options->rolling = TRUE;
+         options->ledger_options.days = TRUE;
+
+         continue;
+      }
+
+      if(strcmp(argument_vector[i], CATEGORIES_OPTION) == 0) {
+         options->ledger_options.categories = TRUE;
+
+         continue;
+      }
+
+      /*
+       * Normalized categories are still categories, so --normalize on its
+       * own is enough.
+       */
+      if(strcmp(argument_vector[i], NORMALIZE_OPTION) == 0) {
+         options->ledger_options.categories = TRUE;
+         options->ledger_options.normalize_categories = TRUE;
+
+         continue;
+      }
+
+      if(strcmp(argument_vector[i], FROM_OPTION) == 0
+         || strcmp(argument_vector[i], TO_OPTION) == 0) {
+
+         if(add_date_range_argument(options, argument_vector[i],
+            i + 1 < argument_count ? argument_vector[i + 1] : NULL) != 0) {
+
+            return ARGUMENT_ERROR;
+         }
+
+         i++;
+
+         continue;
+      }
+
+      if(is_option(argument_vector[i]) == TRUE) {
+         printf("\nUnknown option %s.\n", argument_vector[i]);
+
+         return ARGUMENT_ERROR;
+      }
+
+      /*
+       * Make sure the data file name length is within the valid range.
+       */
+      if(string_length_within_range(argument_vector[i], FILE_NAME_LENGTH)
+         == FALSE) {
+
+         printf("\nData file name exceeds maximum number of %d",
+               FILE_NAME_LENGTH);
+         printf(" allowable characters.\n");
+
+         return FILE_ERROR;
+      }
+
+      if(options->data_file_count == 0) {
+         (void) strcpy(options->data_file_name, argument_vector[i]);
+      }
+
+      if(is_file_group(argument_vector[i]) == TRUE) {
+         options->multiple_files = TRUE;
+      }
+
+      /*
+       * The file arguments are gathered at the front of argument_vector.
+       * Every argument moved has already been looked at, so nothing still to
+       * come is overwritten.
+       */
+      options->data_file_arguments[options->data_file_count++]
+         = argument_vector[i];
+   }
+
+   if(options->data_file_count > 1) {
+      options->multiple_files = TRUE;
+   }
+
+   if(options->multiple_files == TRUE) {
+      if(options->use_cache == TRUE || options->incremental == TRUE
+         || options->follow == TRUE) {
+
+         printf("\n%s, %s and %s can only be used with one budget data",
+            CACHE_OPTION, INCREMENTAL_OPTION, FOLLOW_OPTION);
+         printf(" file.\n");
+
+         return ARGUMENT_ERROR;
+      }
+
+      for(i = 0; i < options->data_file_count; i++) {
+         if(strcmp(options->data_file_arguments[i], STANDARD_INPUT_FILE_NAME)
+            == 0) {
+
+            printf("\nStandard input can only be read on its own.\n");
+
+            return ARGUMENT_ERROR;
+         }
+      }
+   }
+
+   /*
+    * The other formats only have the yearly, large transaction and monthly
+    * figures, so anything more has to be asked for as tables.
+    */
+   if(options->output_format != TABLE_FORMAT
+      && (options->ledger_options.categories == TRUE
+      || options->ledger_options.top_count > 0
+      || options->ledger_options.quantiles == TRUE
+      || options->ledger_options.band_count > 0
+      || options->date_range_count > 0 || options->rolling == TRUE)) {
+
+      printf("\n%s, %s, %s, %s, %s, %s and %s can only be used with",
+         CATEGORIES_OPTION, TOP_OPTION, QUANTILES_OPTION, BANDS_OPTION,
+         FROM_OPTION, TO_OPTION, ROLLING_OPTION);
+      printf(" %s table.\n", FORMAT_OPTION);
+
+      return ARGUMENT_ERROR;
+   }
+
+   /*
+    * A cache file or checkpoint must never be saved from a file with bad
+    * lines left out, and a followed file is never read to the end.
+    */
+   if(options->all_errors == TRUE && (options->use_cache == TRUE
+      || options->incremental == TRUE || options->follow == TRUE)) {
+
+      printf("\n%s can't be used with %s, %s or %s.\n", ALL_ERRORS_OPTION,
+         CACHE_OPTION, INCREMENTAL_OPTION, FOLLOW_OPTION);
+
+      return ARGUMENT_ERROR;
+   }
+
+   if(options->check_only == TRUE && (options->use_cache == TRUE
+      || options->incremental == TRUE || options->follow == TRUE)) {
+
+      printf("\n%s can't be used with %s, %s or %s.\n", CHECK_OPTION,
+         CACHE_OPTION, INCREMENTAL_OPTION, FOLLOW_OPTION);
+
+      return ARGUMENT_ERROR;
+   }
+
+   if(options->use_cache == TRUE && options->incremental == TRUE) {
+      printf("\n%s and %s can't be used together.\n", CACHE_OPTION,
+         INCREMENTAL_OPTION);
+
+      return ARGUMENT_ERROR;
+   }
+
+   /*
+    * A followed file is always read in blocks, since a memory-mapped file
+    * can't grow.
+    */
+   if(options->follow == TRUE) {
+#ifdef POSIX_PLATFORM
+      if(options->use_cache == TRUE || options->incremental == TRUE) {
+         printf("\n%s can't be used with %s or %s.\n", FOLLOW_OPTION,
+            CACHE_OPTION, INCREMENTAL_OPTION);
+
+         return ARGUMENT_ERROR;
+      }
+
+      if(strcmp(options->data_file_name, STANDARD_INPUT_FILE_NAME) == 0) {
+         printf("\n%s needs the name of a budget data file.\n",
+            FOLLOW_OPTION);
+
+         return ARGUMENT_ERROR;
+      }
+
+      options->allow_mapping = FALSE;
+#else
+      printf("\n%s is not available on this platform.\n", FOLLOW_OPTION);
+
+      return ARGUMENT_ERROR;
+#endif
+   }
+
+   return 0;
+}
+
+/*
+ * Add the date after --from or --to to the date ranges. --from always starts
+ * a new range. --to ends the range started by the --from just before it, or
+ * if there isn't one, starts and ends a range going back to the earliest
+ * transaction. A range with no --to goes on to the latest transaction.
+ *
+ * Return 0 if successful. Return ARGUMENT_ERROR, otherwise.
+ */
+int add_date_range_argument(Program_options *options, const char *option,
+   const char *argument) {
+
+   int day_number = 0;
+   Date_range *range = NULL;
+
+   if(argument == NULL || get_date_argument(argument, &day_number) == FALSE) {
+      printf("\n%s must be followed by a date in the form mm/dd/yyyy.\n",
+         option);
+
+      return ARGUMENT_ERROR;
+   }
+
+   if(strcmp(option, TO_OPTION) == 0 && options->date_range_count > 0) {
+      range = &options->date_ranges[options->date_range_count - 1];
+
+      if(range->has_first_day == FALSE || range->has_last_day == TRUE) {
+         range = NULL;
+      }
+   }
+
+   if(range == NULL) {
+      if(options->date_range_count == MAX_DATE_RANGES) {
+         printf("\nUp to %d date ranges allowed.\n", MAX_DATE_RANGES);
+
+         return ARGUMENT_ERROR;
+      }
+
+      range = &options->date_ranges[options->date_range_count++];
+      init_date_range(range);
+   }
+
+   if(strcmp(option, FROM_OPTION) == 0) {
+      range->has_first_day = TRUE;
+      range->first_day = day_number;
+   }
+   else {
+      range->has_last_day = TRUE;
+      range->last_day = day_number;
+
+      if(range->last_day < range->first_day) {
+         printf("\nThe date after %s is before the date after %s.\n",
+            TO_OPTION, FROM_OPTION);
+
+         return ARGUMENT_ERROR;
+      }
+   }
+
+   /*
+    * Date ranges are added up from the figures for each day.
+    */
+   options->ledger_options.days = TRUE;
+
+   return 0;
+}
+
+/*
+ * Convert argument, a date in the form mm/dd/yyyy, to a day number (see
+ * DAY_NUMBER in ledger.h).
+ */
+Bool get_date_argument(const char *argument, int *day_number) {
+
+   int month;
+   int day;
+   int year;
+
+   if(parse_date(argument, &month, &day, &year) == FALSE) {
+      return FALSE;
+   }
+
+   *day_number = DAY_NUMBER(year, month, day);
+
+   return TRUE;
+}
+
+/*
+ * Fill in the amount bands from argument, a list of amounts separated by
+ * commas. The amounts are written the same way as in a budget file and
+ * must go from lowest to highest. n amounts make n + 1 bands.
+ */
+Bool get_bands_argument(const char *argument, Ledger_options *options) {
+
+   const char *end;
+   Cents *cutoffs = options->band_cutoffs;
+   int cutoff_count = 0;
+
+   for(;;) {
+      end = strchr(argument, ',');
+
+      if(end == NULL) {
+         end = argument + strlen(argument);
+      }
+
+      if(cutoff_count == MAX_AMOUNT_BANDS - 1
+         || parse_amount(argument, (size_t) (end - argument),
+         &cutoffs[cutoff_count]) == FALSE
+         || (cutoff_count > 0
+         && cutoffs[cutoff_count] <= cutoffs[cutoff_count - 1])) {
+
+         return FALSE;
+      }
+
+      cutoff_count++;
+
+      if(*end == '\0') {
+         break;
+      }
+
+      argument = end + 1;
+   }
+
+   options->band_count = cutoff_count + 1;
+
+   return TRUE;
+}
+
+/*
+ * Set format from the name after --format. Return FALSE if it isn't one of
+ * the formats.
+ */
+Bool get_format_argument(const char *argument, int *format) {
+
+   if(strcmp(argument, "table") == 0) {
+      *format = TABLE_FORMAT;
+   }
+   else if(strcmp(argument, "csv") == 0) {
+      *format = CSV_FORMAT;
+   }
+   else if(strcmp(argument, "jsonl") == 0) {
+      *format = JSONL_FORMAT;
+   }
+   else if(strcmp(argument, "bin") == 0) {
+      *format = BINARY_FORMAT;
+   }
+   else {
+      return FALSE;
+   }
+
+   return TRUE;
+}
+
+/*
+ * Options start with a dash. A dash on its own is a file name (standard
+ * input).
+ */
+Bool is_option(const char *argument) {
+   if(argument[0] == '-' && argument[1] != '\0') {
+      return TRUE;
+   }
+   else {
+      return FALSE;
+   }
+}
+
+/*
+ * Convert argument to a number. The whole argument must be a number from
+ * minimum to maximum, inclusive.
+ */
+Bool get_number_argument(const char *argument, int minimum, int maximum,
+   int *number) {
+
+   long int result = 0;
+   char *end_ptr;
+
+   result = strtol(argument, &end_ptr, 10);
+
+   if(end_ptr == argument || *end_ptr != '\0' || result < minimum
+      || result > maximum) {
+
+      return FALSE;
+   }
+
+   *number = (int) result;
+
+   return TRUE;
+}
+
+Bool string_length_within_range(const char *s, int maximum_string_length)
+{
+   int i = 0;
+
+   while(*s) {
+      s++;
+      i++;
+
+      if(i > maximum_string_length) {
+         return FALSE;
+      }
+   }
+
+   return TRUE;
+}
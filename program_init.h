@@ -1,35 +1,94 @@
-/*
- * Name:       program_init.h
- *
- * Purpose:    Macro definitions and directives for program_init.c.
- *
- * Author:     jjones4
- *
- * Copyright (c) 2024 Jerad Jones
- *
- * This file is part of c_budget. c_budget may be freely distributed under the
- * MIT license. For all details and documentation, see:
- *
- *             https://github.com/jjones4/c_budget
- */
-
-#ifndef PROGRAM_INIT_H
-
-#define PROGRAM_INIT_H
-
-#include <stdio.h>
-#include "boolean.h"
-
-/*
- * c_budget assumes DEFAULT_DATA_FILE is the name of the budget data file if
- * user does not provide user-defined file name as a command line argument.
- */
-#define DEFAULT_DATA_FILE "budget_data.txt"
-#define FILE_NAME_LENGTH 100
-#define MAX_ARG_COUNT 2
-#define MIN_ARG_COUNT 1
-
-int program_init(int argument_count, char **argument_vector,
-   char **data_file_name);
-
-#endif
\ No newline at end of file
+/*
+ * Name:       program_init.h
+ *
+ * Purpose:    Macro definitions and directives for program_init.c.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#ifndef PROGRAM_INIT_H
+
+#define PROGRAM_INIT_H
+
+#include <stdio.h>
+#include "boolean.h"
+#include "ledger.h"
+#include "date_ranges.h"
+
+/*
+ * c_budget assumes DEFAULT_DATA_FILE is the name of the budget data file if
+ * user does not provide user-defined file name as a command line argument.
+ */
+#define DEFAULT_DATA_FILE "budget_data.txt"
+#define FILE_NAME_LENGTH 100
+
+/*
+ * Command-line options.
+ */
+#define THREAD_COUNT_OPTION "-j"
+#define MAX_THREAD_COUNT 256
+#define STREAM_OPTION "--stream"
+#define CACHE_OPTION "--cache"
+#define INCREMENTAL_OPTION "--incremental"
+#define FOLLOW_OPTION "--follow"
+#define CATEGORIES_OPTION "--categories"
+#define NORMALIZE_OPTION "--normalize"
+#define FROM_OPTION "--from"
+#define TO_OPTION "--to"
+#define TOP_OPTION "--top"
+#define QUANTILES_OPTION "--quantiles"
+#define ROLLING_OPTION "--rolling"
+#define BANDS_OPTION "--bands"
+#define OUTPUT_OPTION "-o"
+#define FORMAT_OPTION "--format"
+#define ALL_ERRORS_OPTION "--all-errors"
+#define CHECK_OPTION "--check"
+
+/*
+ * The forms the figures can be written in: the tables, or one of the formats
+ * for other programs (see export_budget_figures.c).
+ */
+#define TABLE_FORMAT 0
+#define CSV_FORMAT 1
+#define JSONL_FORMAT 2
+#define BINARY_FORMAT 3
+
+/*
+ * Everything the user asked for on the command line. data_file_name is the
+ * first budget file given. data_file_arguments holds all of them, along with
+ * any directories and patterns, in the order they were given. If there is
+ * more than one file to read, multiple_files is TRUE. output_file_name is
+ * NULL unless the figures are to be written to a file instead of standard
+ * output.
+ */
+typedef struct {
+   char data_file_name[FILE_NAME_LENGTH + 1];
+   char **data_file_arguments;
+   int data_file_count;
+   Bool multiple_files;
+   int thread_count;
+   Bool allow_mapping;
+   Bool use_cache;
+   Bool incremental;
+   Bool follow;
+   Ledger_options ledger_options;
+   Date_range date_ranges[MAX_DATE_RANGES];
+   int date_range_count;
+   Bool rolling;
+   const char *output_file_name;
+   int output_format;
+   Bool all_errors;
+   Bool check_only;
+} Program_options;
+
+int program_init(int argument_count, char **argument_vector,
+   Program_options *options);
+
+#endif
@@ -0,0 +1,132 @@
+/*
+ * Name:       quantiles.c
+ *
+ * Purpose:    Functions for estimating the median and other percentiles of a
+ *             set of amounts in a fixed amount of memory.
+ *
+ *             Each amount is only counted in the bucket it falls in, and the
+ *             buckets are the same for every sketch, so two sketches are
+ *             merged by adding up their buckets. The bucket widths grow with
+ *             the amounts, so the error is always a small fraction of the
+ *             amount rather than a fixed number of cents. Finding the bucket
+ *             only takes integer arithmetic.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#include "quantiles.h"
+
+int get_quantile_bucket(Cents amount);
+Cents get_bucket_middle(int bucket);
+
+void clear_quantile_sketch(Quantile_sketch *sketch) {
+
+   int i;
+
+   sketch->count = 0;
+
+   for(i = 0; i < QUANTILE_BUCKET_COUNT; i++) {
+      sketch->buckets[i] = 0;
+   }
+}
+
+/*
+ * Count amount, which is made positive first, in sketch.
+ */
+void add_to_quantile_sketch(Quantile_sketch *sketch, Cents amount) {
+
+   sketch->buckets[get_quantile_bucket(amount < 0 ? -amount : amount)]++;
+   sketch->count++;
+}
+
+void merge_quantile_sketch(Quantile_sketch *total,
+   const Quantile_sketch *sketch) {
+
+   int i;
+
+   for(i = 0; i < QUANTILE_BUCKET_COUNT; i++) {
+      total->buckets[i] += sketch->buckets[i];
+   }
+
+   total->count += sketch->count;
+}
+
+/*
+ * Return the amount percent percent of the way through the sketch (50 for
+ * the median), or 0 if the sketch is empty. This is the amount that at least
+ * percent percent of the amounts are less than or equal to.
+ */
+Cents get_quantile(const Quantile_sketch *sketch, int percent) {
+
+   Uint64 rank;
+   Uint64 seen = 0;
+   int i;
+
+   if(sketch->count == 0) {
+      return 0;
+   }
+
+   /*
+    * Splitting the multiplication keeps it from overflowing.
+    */
+   rank = sketch->count / 100 * percent
+      + (sketch->count % 100 * percent + 99) / 100;
+
+   if(rank == 0) {
+      rank = 1;
+   }
+
+   for(i = 0; i < QUANTILE_BUCKET_COUNT; i++) {
+      seen += sketch->buckets[i];
+
+      if(seen >= rank) {
+         break;
+      }
+   }
+
+   return get_bucket_middle(i);
+}
+
+/*
+ * Amounts below QUANTILE_EXACT_LIMIT are their own buckets. Any other amount
+ * has a highest bit b, and goes in one of the QUANTILE_SUB_BUCKETS buckets
+ * for amounts with that highest bit, picked by the next
+ * QUANTILE_SUB_BUCKET_BITS bits down.
+ */
+int get_quantile_bucket(Cents amount) {
+
+   int shift = 0;
+
+   if(amount >= QUANTILE_AMOUNT_LIMIT) {
+      amount = QUANTILE_AMOUNT_LIMIT - 1;
+   }
+
+   while((amount >> shift) >= QUANTILE_EXACT_LIMIT) {
+      shift++;
+   }
+
+   return (int) (QUANTILE_SUB_BUCKETS * shift + (amount >> shift));
+}
+
+/*
+ * Return the amount halfway through bucket, to stand for all of the amounts
+ * in it.
+ */
+Cents get_bucket_middle(int bucket) {
+
+   int shift = 0;
+
+   while(bucket >= QUANTILE_EXACT_LIMIT) {
+      bucket -= QUANTILE_SUB_BUCKETS;
+      shift++;
+   }
+
+   return ((Cents) bucket << shift) + (((Cents) 1 << shift) >> 1);
+}
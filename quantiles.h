@@ -0,0 +1,53 @@
+/*
+ * Name:       quantiles.h
+ *
+ * Purpose:    Typedefs, macros and function definitions for quantiles.c.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#ifndef QUANTILES_H
+
+#define QUANTILES_H
+
+#include "integer_types.h"
+#include "cents.h"
+
+/*
+ * Amounts below QUANTILE_EXACT_LIMIT cents each have a bucket of their own.
+ * Above that, every power of two is split into QUANTILE_SUB_BUCKETS buckets
+ * of equal width, which is enough buckets for amounts up to
+ * QUANTILE_AMOUNT_LIMIT cents (a little over the largest amount a budget
+ * line can have).
+ */
+#define QUANTILE_SUB_BUCKET_BITS 5
+#define QUANTILE_SUB_BUCKETS (1 << QUANTILE_SUB_BUCKET_BITS)
+#define QUANTILE_EXACT_LIMIT (2 * QUANTILE_SUB_BUCKETS)
+#define QUANTILE_AMOUNT_BITS 24
+#define QUANTILE_AMOUNT_LIMIT (1L << QUANTILE_AMOUNT_BITS)
+#define QUANTILE_BUCKET_COUNT (QUANTILE_SUB_BUCKETS \
+   * (QUANTILE_AMOUNT_BITS - QUANTILE_SUB_BUCKET_BITS + 1))
+
+/*
+ * How many amounts fell into each bucket. A quantile read back from a sketch
+ * is within 1 / (2 * QUANTILE_SUB_BUCKETS) of the true value (about 1.6%).
+ */
+typedef struct {
+   Uint64 count;
+   Uint64 buckets[QUANTILE_BUCKET_COUNT];
+} Quantile_sketch;
+
+void clear_quantile_sketch(Quantile_sketch *sketch);
+void add_to_quantile_sketch(Quantile_sketch *sketch, Cents amount);
+void merge_quantile_sketch(Quantile_sketch *total,
+   const Quantile_sketch *sketch);
+Cents get_quantile(const Quantile_sketch *sketch, int percent);
+
+#endif
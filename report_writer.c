@@ -0,0 +1,395 @@
+/*
+ * Name:       report_writer.c
+ *
+ * Purpose:    Build up the budget figures report in memory and write it out
+ *             in one go.
+ *
+ *             The tables are made of fixed-width columns, so instead of
+ *             going through printf for every row, each piece is copied or
+ *             formatted straight into one buffer. Amounts are turned into
+ *             decimal digits from right to left, directly in place. When the
+ *             report is finished, the whole buffer is handed to a single
+ *             write(), so a report going down a pipe isn't sent a line at a
+ *             time.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <string.h>
+#include "return_codes.h"
+#include "integer_types.h"
+#include "budget_memory.h"
+#include "report_writer.h"
+
+#ifdef POSIX_PLATFORM
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/*
+ * The most characters one amount or number can take up, not counting
+ * padding.
+ */
+#define NUMBER_FIELD_LENGTH CENTS_STRING_LENGTH
+
+Bool make_report_room(Report_writer *writer, size_t room);
+void write_report_spaces(Report_writer *writer, size_t count);
+size_t format_magnitude(Uint64 magnitude, Bool negative, int fraction_digits,
+   char *end);
+void write_report_digits(Report_writer *writer, Uint64 magnitude,
+   Bool negative, int fraction_digits, int width);
+void flush_report_buffer(Report_writer *writer);
+
+/*
+ * Start an empty report. output_file_name is NULL for standard output. The
+ * file isn't opened until the report is written.
+ */
+void open_report_writer(Report_writer *writer, const char *output_file_name) {
+
+   writer->output_file_name = output_file_name;
+   writer->output_opened = FALSE;
+   writer->write_error = FALSE;
+   writer->buffer = NULL;
+   writer->length = 0;
+   writer->capacity = 0;
+   writer->growth_count = 0;
+}
+
+void write_report_text(Report_writer *writer, const char *text) {
+
+   write_report_bytes(writer, text, strlen(text));
+}
+
+/*
+ * Write length bytes of text, padded with spaces to width characters. As
+ * with printf, a negative width pads on the right instead of the left.
+ */
+void write_report_field(Report_writer *writer, const char *text,
+   size_t length, int width) {
+
+   size_t padding = 0;
+
+   if(width < 0 && (size_t) -width > length) {
+      padding = (size_t) -width - length;
+   }
+   else if(width > 0 && (size_t) width > length) {
+      padding = (size_t) width - length;
+   }
+
+   if(width > 0) {
+      write_report_spaces(writer, padding);
+   }
+
+   write_report_bytes(writer, text, length);
+
+   if(width < 0) {
+      write_report_spaces(writer, padding);
+   }
+}
+
+/*
+ * Write amount in the form -1234.56, padded on the left to width characters.
+ */
+void write_report_cents(Report_writer *writer, Cents amount, int width) {
+
+   /*
+    * Work with the magnitude as an unsigned number so that the most negative
+    * amount doesn't overflow when its sign is flipped.
+    */
+   if(amount < 0) {
+      write_report_digits(writer, (Uint64) 0 - (Uint64) amount, TRUE, 2,
+         width);
+   }
+   else {
+      write_report_digits(writer, (Uint64) amount, FALSE, 2, width);
+   }
+}
+
+/*
+ * Write number, padded on the left to width characters.
+ */
+void write_report_number(Report_writer *writer, long number, int width) {
+
+   if(number < 0) {
+      write_report_digits(writer, (Uint64) 0 - (Uint64) number, TRUE, 0,
+         width);
+   }
+   else {
+      write_report_digits(writer, (Uint64) number, FALSE, 0, width);
+   }
+}
+
+/*
+ * Write out the report and free the buffer.
+ *
+ * Return 0 if successful. Return FILE_ERROR if the output file could not be
+ * opened or written.
+ */
+int close_report_writer(Report_writer *writer) {
+
+   flush_report_buffer(writer);
+
+#ifdef POSIX_PLATFORM
+   if(writer->output_opened == TRUE && writer->output_file_name != NULL
+      && close(writer->fd) != 0) {
+
+      writer->write_error = TRUE;
+   }
+#else
+   if(writer->output_opened == TRUE && writer->output_file_name != NULL
+      && fclose(writer->fp) != 0) {
+
+      writer->write_error = TRUE;
+   }
+#endif
+
+   if(writer->buffer != writer->spare_buffer) {
+      budget_free(writer->buffer);
+   }
+
+   writer->buffer = NULL;
+   writer->length = 0;
+   writer->capacity = 0;
+
+   return writer->write_error == TRUE ? FILE_ERROR : 0;
+}
+
+/*
+ * Make sure there is room for room more bytes, growing the buffer if needed.
+ * If it can't grow, what there is so far is written out and the rest of the
+ * report goes through the spare buffer.
+ *
+ * Return TRUE if there is room. Return FALSE if room is bigger than the spare
+ * buffer and the buffer couldn't grow.
+ */
+Bool make_report_room(Report_writer *writer, size_t room) {
+
+   char *buffer;
+
+   if(writer->length + room <= writer->capacity) {
+      return TRUE;
+   }
+
+   if(writer->buffer != writer->spare_buffer) {
+      buffer = grow_array(writer->buffer, 1, writer->length,
+         &writer->capacity, writer->length + room,
+         INITIAL_REPORT_BUFFER_SIZE, &writer->growth_count);
+
+      if(buffer != NULL) {
+         writer->buffer = buffer;
+
+         return TRUE;
+      }
+   }
+
+   flush_report_buffer(writer);
+
+   if(writer->buffer != writer->spare_buffer) {
+      budget_free(writer->buffer);
+      writer->buffer = writer->spare_buffer;
+      writer->capacity = SPARE_REPORT_BUFFER_SIZE;
+   }
+
+   return room <= writer->capacity ? TRUE : FALSE;
+}
+
+/*
+ * Copy bytes into the report, a piece at a time if the spare buffer is in
+ * use and they don't all fit.
+ */
+void write_report_bytes(Report_writer *writer, const char *bytes,
+   size_t length) {
+
+   size_t piece;
+
+   while(length > 0) {
+      if(make_report_room(writer, length) == TRUE) {
+         piece = length;
+      }
+      else {
+         piece = writer->capacity - writer->length;
+      }
+
+      (void) memcpy(writer->buffer + writer->length, bytes, piece);
+      writer->length += piece;
+      bytes += piece;
+      length -= piece;
+   }
+}
+
+void write_report_spaces(Report_writer *writer, size_t count) {
+
+   size_t piece;
+
+   while(count > 0) {
+      if(make_report_room(writer, count) == TRUE) {
+         piece = count;
+      }
+      else {
+         piece = writer->capacity - writer->length;
+      }
+
+      (void) memset(writer->buffer + writer->length, ' ', piece);
+      writer->length += piece;
+      count -= piece;
+   }
+}
+
+/*
+ * Write the digits of magnitude backwards from just before end, with a
+ * decimal point before the last fraction_digits of them and a minus sign in
+ * front if negative. There is always at least one digit before the decimal
+ * point (0.05, not .05).
+ *
+ * Return the number of characters written.
+ */
+size_t format_magnitude(Uint64 magnitude, Bool negative, int fraction_digits,
+   char *end) {
+
+   char *start = end;
+   int digit_count = 0;
+
+   do {
+      if(digit_count == fraction_digits && fraction_digits > 0) {
+         *--start = '.';
+      }
+
+      *--start = (char) ('0' + magnitude % 10);
+      magnitude /= 10;
+      digit_count++;
+   } while(magnitude > 0 || digit_count <= fraction_digits);
+
+   if(negative == TRUE) {
+      *--start = '-';
+   }
+
+   return (size_t) (end - start);
+}
+
+/*
+ * Write a number padded on the left to width characters. The number is
+ * formatted at the end of the field and then slid up against its padding,
+ * all within the report buffer.
+ */
+void write_report_digits(Report_writer *writer, Uint64 magnitude,
+   Bool negative, int fraction_digits, int width) {
+
+   char *field;
+   size_t field_width = width > 0 ? (size_t) width : 0;
+   size_t length;
+
+   if(field_width < NUMBER_FIELD_LENGTH) {
+      field_width = NUMBER_FIELD_LENGTH;
+   }
+
+   if(make_report_room(writer, field_width) == FALSE) {
+      return;
+   }
+
+   field = writer->buffer + writer->length;
+   length = format_magnitude(magnitude, negative, fraction_digits,
+      field + field_width);
+
+   if(width > 0 && (size_t) width > length) {
+      (void) memmove(field + width - length, field + field_width - length,
+         length);
+      (void) memset(field, ' ', width - length);
+      writer->length += width;
+   }
+   else {
+      (void) memmove(field, field + field_width - length, length);
+      writer->length += length;
+   }
+}
+
+#ifdef POSIX_PLATFORM
+
+/*
+ * Hand everything in the buffer to write(), opening the output first if
+ * this is the first time. Anything printed with printf before the report is
+ * written out first, so messages stay in order.
+ */
+void flush_report_buffer(Report_writer *writer) {
+
+   size_t written = 0;
+   ssize_t write_result;
+
+   if(writer->output_opened == FALSE) {
+      if(writer->output_file_name == NULL) {
+         writer->fd = STDOUT_FILENO;
+      }
+      else {
+         writer->fd = open(writer->output_file_name,
+            O_WRONLY | O_CREAT | O_TRUNC, 0666);
+      }
+
+      if(writer->fd == -1) {
+         writer->write_error = TRUE;
+      }
+
+      writer->output_opened = TRUE;
+   }
+
+   (void) fflush(stdout);
+
+   while(writer->write_error == FALSE && written < writer->length) {
+      write_result = write(writer->fd, writer->buffer + written,
+         writer->length - written);
+
+      if(write_result > 0) {
+         written += (size_t) write_result;
+      }
+      else if(write_result == -1 && errno == EINTR) {
+         continue;
+      }
+      else {
+         writer->write_error = TRUE;
+      }
+   }
+
+   writer->length = 0;
+}
+
+#else
+
+/*
+ * Without POSIX, the buffer is handed to a single fwrite() instead.
+ */
+void flush_report_buffer(Report_writer *writer) {
+
+   if(writer->output_opened == FALSE) {
+      if(writer->output_file_name == NULL) {
+         writer->fp = stdout;
+      }
+      else {
+         writer->fp = fopen(writer->output_file_name, "w");
+      }
+
+      if(writer->fp == NULL) {
+         writer->write_error = TRUE;
+      }
+
+      writer->output_opened = TRUE;
+   }
+
+   if(writer->write_error == FALSE && writer->length > 0
+      && (fwrite(writer->buffer, 1, writer->length, writer->fp)
+      != writer->length || fflush(writer->fp) != 0)) {
+
+      writer->write_error = TRUE;
+   }
+
+   writer->length = 0;
+}
+
+#endif
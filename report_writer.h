@@ -0,0 +1,64 @@
+/*
+ * Name:       report_writer.h
+ *
+ * Purpose:    Typedefs, macros and function definitions for report_writer.c.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#ifndef REPORT_WRITER_H
+
+#define REPORT_WRITER_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include "platform.h"
+#include "boolean.h"
+#include "cents.h"
+
+/*
+ * The report buffer starts out this big and doubles as needed. If it can't
+ * grow, the report is written out SPARE_REPORT_BUFFER_SIZE bytes at a time
+ * instead, which is always enough for one amount or number.
+ */
+#define INITIAL_REPORT_BUFFER_SIZE 65536
+#define SPARE_REPORT_BUFFER_SIZE 4096
+
+/*
+ * Collects a report in memory so it can be written out all at once, to
+ * standard output or to the file named output_file_name.
+ */
+typedef struct {
+   const char *output_file_name;
+   Bool output_opened;
+   Bool write_error;
+#ifdef POSIX_PLATFORM
+   int fd;
+#else
+   FILE *fp;
+#endif
+   char *buffer;
+   size_t length;
+   size_t capacity;
+   unsigned long growth_count;
+   char spare_buffer[SPARE_REPORT_BUFFER_SIZE];
+} Report_writer;
+
+void open_report_writer(Report_writer *writer, const char *output_file_name);
+void write_report_bytes(Report_writer *writer, const char *bytes,
+   size_t length);
+void write_report_text(Report_writer *writer, const char *text);
+void write_report_field(Report_writer *writer, const char *text,
+   size_t length, int width);
+void write_report_cents(Report_writer *writer, Cents amount, int width);
+void write_report_number(Report_writer *writer, long number, int width);
+int close_report_writer(Report_writer *writer);
+
+#endif
@@ -0,0 +1,107 @@
+/*
+ * Name:       rolling_windows.c
+ *
+ * Purpose:    Functions for adding up the net margins over rolling windows
+ *             of days.
+ *
+ *             The days of a ledger are gone through once, from the first day
+ *             with a transaction to the last. Each window's total has the new
+ *             day added and the day falling out of the window taken away, so
+ *             the time taken doesn't depend on how long the windows are.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#include "validate_budget_line.h"
+#include "rolling_windows.h"
+
+Bool is_used_day(const Day_figures *day_figures);
+
+/*
+ * Fill in windows for ledger, which must keep days and have at least one
+ * transaction. Only days that are on the calendar count toward the length
+ * of a window, so a 30-day window ending on March 1st starts on January 31st
+ * or February 1st. A window starting before the first transaction has
+ * nothing on the days before it. Only full windows, starting on or after
+ * the first transaction, can be the worst.
+ */
+void get_rolling_windows(const Ledger *ledger,
+   Rolling_window windows[ROLLING_WINDOW_COUNT]) {
+
+   const int lengths[ROLLING_WINDOW_COUNT] = ROLLING_WINDOW_LENGTHS;
+   Cents recent_margins[LONGEST_ROLLING_WINDOW];
+   Cents sums[ROLLING_WINDOW_COUNT];
+   Cents margins;
+   const Day_figures *day_figures;
+   int first_day = DAYS_PER_MONTH * ledger->first_used_month;
+   int last_day = DAYS_PER_MONTH * (ledger->last_used_month + 1) - 1;
+   int day;
+   long day_count = 0;
+   int i;
+
+   while(is_used_day(get_day_figures(ledger, first_day)) == FALSE) {
+      first_day++;
+   }
+
+   while(is_used_day(get_day_figures(ledger, last_day)) == FALSE) {
+      last_day--;
+   }
+
+   for(i = 0; i < ROLLING_WINDOW_COUNT; i++) {
+      windows[i].length = lengths[i];
+      windows[i].has_worst = FALSE;
+      sums[i] = 0;
+   }
+
+   for(day = first_day; day <= last_day; day++) {
+      if(is_valid_day(day / DAYS_PER_MONTH % 12 + 1,
+         day % DAYS_PER_MONTH + 1, day / DAYS_PER_MONTH / 12) == FALSE) {
+
+         continue;
+      }
+
+      day_figures = get_day_figures(ledger, day);
+      margins = day_figures->credits + day_figures->debits;
+
+      for(i = 0; i < ROLLING_WINDOW_COUNT; i++) {
+         sums[i] += margins;
+
+         if(day_count >= lengths[i]) {
+            sums[i] -= recent_margins[(day_count - lengths[i])
+               % LONGEST_ROLLING_WINDOW];
+         }
+
+         if(day_count + 1 >= lengths[i] && (windows[i].has_worst == FALSE
+            || sums[i] < windows[i].worst_margins)) {
+
+            windows[i].has_worst = TRUE;
+            windows[i].worst_margins = sums[i];
+            windows[i].worst_last_day = day;
+         }
+      }
+
+      recent_margins[day_count % LONGEST_ROLLING_WINDOW] = margins;
+      day_count++;
+   }
+
+   for(i = 0; i < ROLLING_WINDOW_COUNT; i++) {
+      windows[i].latest_margins = sums[i];
+      windows[i].latest_last_day = last_day;
+   }
+}
+
+Bool is_used_day(const Day_figures *day_figures) {
+
+   if(day_figures->credits != 0 || day_figures->debits != 0) {
+      return TRUE;
+   }
+
+   return FALSE;
+}
@@ -0,0 +1,53 @@
+/*
+ * Name:       rolling_windows.h
+ *
+ * Purpose:    Typedefs, macros and function definitions for
+ *             rolling_windows.c.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#ifndef ROLLING_WINDOWS_H
+
+#define ROLLING_WINDOWS_H
+
+#include "boolean.h"
+#include "cents.h"
+#include "ledger.h"
+
+/*
+ * The lengths, in days, of the rolling windows. The longest must be last.
+ */
+#define ROLLING_WINDOW_COUNT 3
+#define ROLLING_WINDOW_LENGTHS { 30, 90, 365 }
+#define LONGEST_ROLLING_WINDOW 365
+
+/*
+ * The net margin over the length days up to and including the last day with
+ * a transaction, and the lowest net margin over any length days in a row.
+ * The days are day numbers (see DAY_NUMBER in ledger.h) of the last day of
+ * each window.
+ *
+ * has_worst is FALSE if the data covers fewer than length days, in which
+ * case there is no full window to be the worst.
+ */
+typedef struct {
+   int length;
+   Cents latest_margins;
+   int latest_last_day;
+   Bool has_worst;
+   Cents worst_margins;
+   int worst_last_day;
+} Rolling_window;
+
+void get_rolling_windows(const Ledger *ledger,
+   Rolling_window windows[ROLLING_WINDOW_COUNT]);
+
+#endif
@@ -0,0 +1,203 @@
+#!/bin/sh
+#
+# Name:       self_test.sh
+#
+# Purpose:    Read the same made-up budget data in every way c_budget can
+#             read it, and make sure each way gives the same figures.
+#
+#             c_budget asserts that reading lines never allocates memory
+#             (see budget_memory.c), one way for a single reader, another for
+#             a file split between threads and another for several files, so
+#             a run that breaks that rule stops with an assertion failure
+#             here. Build c_budget and generate_budget_data first (see
+#             README.md), without -DNDEBUG, then run this from the same
+#             directory:
+#                ./self_test.sh [--large]
+#
+#             --large also reads a generated file of 100,000,000 lines, far
+#             past the old limit of a million lines and 2^31 bytes, and
+#             checks its line and byte counts and yearly totals against ones
+#             worked out by awk. It needs about 3 GB of disk space and a few
+#             minutes.
+#
+# Author:     jjones4
+#
+# Copyright (c) 2024 Jerad Jones
+#
+# This file is part of c_budget. c_budget may be freely distributed under the
+# MIT license. For all details and documentation, see:
+#
+#             https://github.com/jjones4/c_budget
+
+data=$(mktemp -d)
+trap 'rm -rf "$data"' EXIT
+
+failures=0
+
+# Run c_budget with the given arguments and fail unless it returns 0 and
+# prints the same figures as the first, single reader run.
+check() {
+   name=$1
+   shift
+
+   if ! ./c_budget "$@" > "$data/output.txt"; then
+      echo "FAILED: $name (c_budget $*) returned an error"
+      failures=$((failures + 1))
+   elif [ -f "$data/expected.txt" ] \
+      && ! cmp -s "$data/output.txt" "$data/expected.txt"; then
+
+      echo "FAILED: $name (c_budget $*) printed different figures"
+      failures=$((failures + 1))
+   else
+      echo "ok: $name"
+   fi
+}
+
+# As check, but for --check, which only has to pass.
+check_only() {
+   name=$1
+   shift
+
+   if ! ./c_budget --check "$@" > /dev/null; then
+      echo "FAILED: $name (c_budget --check $*)"
+      failures=$((failures + 1))
+   else
+      echo "ok: $name"
+   fi
+}
+
+./generate_budget_data -n 300000 --seed 1 -o "$data/first.txt" || exit 1
+./generate_budget_data -n 200000 --seed 2 -o "$data/second.txt" || exit 1
+./generate_budget_data -n 100000 --seed 3 -o "$data/third.txt" || exit 1
+cat "$data/first.txt" "$data/second.txt" "$data/third.txt" \
+   > "$data/all.txt"
+mkdir "$data/directory"
+cp "$data/first.txt" "$data/second.txt" "$data/third.txt" "$data/directory"
+
+check "one file" "$data/all.txt"
+cp "$data/output.txt" "$data/expected.txt"
+
+check "one file in blocks" --stream "$data/all.txt"
+check "standard input" - < "$data/all.txt"
+check "one file, 2 threads" -j 2 "$data/all.txt"
+check "one file, 4 threads" -j 4 "$data/all.txt"
+check "several files" "$data/first.txt" "$data/second.txt" \
+   "$data/third.txt"
+check "several files, 3 threads" -j 3 "$data/first.txt" \
+   "$data/second.txt" "$data/third.txt"
+check "several files in blocks, 2 threads" -j 2 --stream \
+   "$data/first.txt" "$data/second.txt" "$data/third.txt"
+check "directory, 4 threads" -j 4 "$data/directory"
+
+check_only "check one file" "$data/all.txt"
+check_only "check one file, 4 threads" -j 4 "$data/all.txt"
+check_only "check several files, 3 threads" -j 3 "$data/directory"
+
+# Print each year's credits and debits, in cents, from a budget file. As in
+# budget_calculations.c, credits of $3000 or more and debits of more than
+# $2400 are large, and are added up apart from the rest.
+add_up_with_awk() {
+   awk -F'|' '{
+      amount = $2
+      sub(/\./, "", amount)
+      amount += 0
+      year = substr($1, 7, 4)
+      if(amount >= 300000) {
+         large_credits[year] += amount
+      }
+      else if(amount >= 0) {
+         credits[year] += amount
+      }
+      else if(amount >= -240000) {
+         debits[year] += amount
+      }
+      else {
+         large_debits[year] += amount
+      }
+      years[year] = 1
+   } END {
+      for(year in years) {
+         printf "%s %.0f %.0f %.0f %.0f\n", year, credits[year],
+            debits[year], large_credits[year], large_debits[year]
+      }
+   }' "$1" | sort
+}
+
+# The same, from c_budget's yearly and monthly large transaction figures.
+add_up_with_c_budget() {
+   ./c_budget --format csv "$@" | awk -F, '{
+      credits = $4
+      debits = $5
+      sub(/\./, "", credits)
+      sub(/\./, "", debits)
+   } $1 == "yearly" {
+      yearly_credits[$2] = credits + 0
+      yearly_debits[$2] = debits + 0
+   } $1 == "large" {
+      large_credits[$2] += credits
+      large_debits[$2] += debits
+   } END {
+      for(year in yearly_credits) {
+         printf "%s %.0f %.0f %.0f %.0f\n", year, yearly_credits[year],
+            yearly_debits[year], large_credits[year], large_debits[year]
+      }
+   }' | sort
+}
+
+if [ "$1" = "--large" ]; then
+   lines=100000000
+   large="$data/large.txt"
+
+   ./generate_budget_data -n $lines --seed 4 -o "$large" || exit 1
+   bytes=$(wc -c < "$large" | tr -d ' ')
+
+   if [ "$bytes" -le 2147483648 ]; then
+      echo "FAILED: $large is only $bytes bytes"
+      failures=$((failures + 1))
+   fi
+
+   if ./c_budget --check "$large" \
+      | grep -q "^OK: $lines lines, $bytes bytes checked"; then
+
+      echo "ok: large file counts"
+   else
+      echo "FAILED: large file counts"
+      failures=$((failures + 1))
+   fi
+
+   add_up_with_awk "$large" > "$data/expected_totals.txt"
+
+   for options in "" "--stream" "-j 4"; do
+      # $options is left unquoted so it splits into separate arguments.
+      add_up_with_c_budget $options "$large" > "$data/totals.txt"
+
+      if [ -s "$data/totals.txt" ] \
+         && cmp -s "$data/totals.txt" "$data/expected_totals.txt"; then
+
+         echo "ok: large file totals $options"
+      else
+         echo "FAILED: large file totals $options"
+         failures=$((failures + 1))
+      fi
+   done
+
+   printf '01/01/2023-1.00|Bad line\n' >> "$large"
+
+   if ./c_budget --stream "$large" \
+      | grep -q "line number $((lines + 1))\$"; then
+
+      echo "ok: large file bad line number"
+   else
+      echo "FAILED: large file bad line number"
+      failures=$((failures + 1))
+   fi
+
+   rm -f "$large"
+fi
+
+if [ "$failures" -ne 0 ]; then
+   echo "$failures checks failed."
+   exit 1
+fi
+
+echo "All checks passed."
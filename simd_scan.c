@@ -0,0 +1,276 @@
+/*
+ * Name:       simd_scan.c
+ *
+ * Purpose:    Check the structure of a budget line 16 or 32 characters at a
+ *             time using SSE2 or AVX2 instructions.
+ *
+ *             Everything from the start of the line up to the second pipe is
+ *             at most 21 characters long, so one or two vector loads cover it.
+ *             Each character is classified at once as a digit, slash, pipe,
+ *             minus sign or decimal point, and the resulting bit masks are
+ *             compared against what a valid line must look like.
+ *
+ *             This is only a fast path. simd_scan_budget_line returns TRUE
+ *             only for lines the character-by-character checks in
+ *             validate_budget_line.c would also accept, and it returns FALSE
+ *             for everything else, including lines it simply can't check
+ *             (too short, or no vector instructions available). The caller
+ *             must then run the character-by-character checks, which decide
+ *             exactly what is wrong with the line. That way the results are
+ *             always identical to the scalar checks.
+ *
+ *             The vector code is only built with GCC or Clang on x86. AVX2 is
+ *             used when select_simd_scan finds that the processor supports
+ *             it. SSE2 is always available on x86-64.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#include "simd_scan.h"
+#include "get_data.h"
+#include "size_limits.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) \
+   || (defined(__i386__) && defined(__SSE2__)))
+#define SIMD_SCAN_X86
+#endif
+
+#ifdef SIMD_SCAN_X86
+#include <immintrin.h>
+#endif
+
+/*
+ * Bit masks over the first characters of a line, one bit per character.
+ */
+#define DATE_DIGIT_BITS 0x3DBUL
+#define DATE_SLASH_BITS 0x024UL
+#define DATE_BITS 0x3FFUL
+#define FIRST_PIPE_BIT 0x400UL
+#define SECOND_PIPE_BITS 0x1FF800UL
+
+/*
+ * Lines must be at least this long to be checked with two overlapping 16
+ * character loads (one at the start of the line, one ending just after the
+ * last place the second pipe can be), or one 32 character load.
+ */
+#define SSE2_SCAN_LENGTH (AMOUNT_OFFSET + AMOUNT_LENGTH_MAX)
+#define AVX2_SCAN_LENGTH 32
+
+/*
+ * Masks of the characters in each class, one bit per character.
+ */
+typedef struct {
+   unsigned long digits;
+   unsigned long slashes;
+   unsigned long pipes;
+   unsigned long minus_signs;
+   unsigned long decimal_points;
+} Character_classes;
+
+Bool check_character_classes(const Character_classes *classes,
+   size_t *amount_length);
+Bool no_simd_scan(const char *line, size_t line_length,
+   size_t *amount_length);
+
+#ifdef SIMD_SCAN_X86
+Bool sse2_scan(const char *line, size_t line_length, size_t *amount_length);
+Bool avx2_scan(const char *line, size_t line_length, size_t *amount_length);
+
+Bool (*scan_function)(const char *, size_t, size_t *) = sse2_scan;
+#else
+Bool (*scan_function)(const char *, size_t, size_t *) = no_simd_scan;
+#endif
+
+/*
+ * Pick the widest instructions the processor supports. Call once before any
+ * lines are scanned (and before any threads are started).
+ */
+void select_simd_scan(void) {
+
+#ifdef SIMD_SCAN_X86
+   __builtin_cpu_init();
+
+   if(__builtin_cpu_supports("avx2")) {
+      scan_function = avx2_scan;
+   }
+   else {
+      scan_function = sse2_scan;
+   }
+#endif
+}
+
+/*
+ * Return TRUE if the line's date, pipes and amount are all correctly placed
+ * and contain only the characters they should, and set amount_length to the
+ * number of characters between the pipes. Return FALSE if the line is not
+ * valid or could not be checked.
+ */
+Bool simd_scan_budget_line(const char *line, size_t line_length,
+   size_t *amount_length) {
+
+   return scan_function(line, line_length, amount_length);
+}
+
+Bool no_simd_scan(const char *line, size_t line_length,
+   size_t *amount_length) {
+
+   (void) line;
+   (void) line_length;
+   (void) amount_length;
+
+   return FALSE;
+}
+
+/*
+ * A valid line looks like this, where the minus sign is optional and there
+ * are 1 to 5 digits before the decimal point:
+ *
+ *    mm/dd/yyyy|-ddddd.dd|
+ */
+Bool check_character_classes(const Character_classes *classes,
+   size_t *amount_length) {
+
+   unsigned long second_pipe;
+   unsigned long amount_bits;
+   unsigned long decimal_point_bit;
+   size_t amount_start = AMOUNT_OFFSET;
+   size_t length = 0;
+   size_t digits_before_decimal_point = 0;
+
+   if((classes->digits & DATE_DIGIT_BITS) != DATE_DIGIT_BITS
+      || (classes->slashes & DATE_BITS) != DATE_SLASH_BITS
+      || (classes->pipes & (DATE_BITS | FIRST_PIPE_BIT)) != FIRST_PIPE_BIT) {
+
+      return FALSE;
+   }
+
+   /*
+    * Isolate the lowest pipe after the first one.
+    */
+   second_pipe = classes->pipes & SECOND_PIPE_BITS;
+   second_pipe &= ~second_pipe + 1;
+
+   if(second_pipe == 0) {
+      return FALSE;
+   }
+
+   while((1UL << (AMOUNT_OFFSET + length)) != second_pipe) {
+      length++;
+   }
+
+   if(classes->minus_signs & (1UL << AMOUNT_OFFSET)) {
+      amount_start++;
+   }
+
+   if(length < AMOUNT_LENGTH_MIN - 1
+      || AMOUNT_OFFSET + length < amount_start + 4) {
+
+      return FALSE;
+   }
+
+   digits_before_decimal_point = AMOUNT_OFFSET + length - amount_start - 3;
+
+   if(digits_before_decimal_point > 5) {
+      return FALSE;
+   }
+
+   decimal_point_bit = 1UL << (AMOUNT_OFFSET + length - 3);
+   amount_bits = (second_pipe - 1) & ~((1UL << amount_start) - 1);
+
+   if((classes->decimal_points & decimal_point_bit) == 0
+      || (classes->digits & (amount_bits & ~decimal_point_bit))
+      != (amount_bits & ~decimal_point_bit)) {
+
+      return FALSE;
+   }
+
+   *amount_length = length;
+
+   return TRUE;
+}
+
+#ifdef SIMD_SCAN_X86
+
+/*
+ * A character c is a digit when c - '0' is at most 9 as an unsigned number.
+ */
+Bool sse2_scan(const char *line, size_t line_length, size_t *amount_length) {
+
+   __m128i front;
+   __m128i back;
+   __m128i nine = _mm_set1_epi8(9);
+   __m128i zero_char = _mm_set1_epi8('0');
+   __m128i shifted;
+   Character_classes classes;
+   int back_offset = SSE2_SCAN_LENGTH - 16;
+
+   if(line_length < SSE2_SCAN_LENGTH) {
+      return FALSE;
+   }
+
+   front = _mm_loadu_si128((const __m128i *) line);
+   back = _mm_loadu_si128((const __m128i *) (line + back_offset));
+
+   shifted = _mm_sub_epi8(front, zero_char);
+   classes.digits = (unsigned long) _mm_movemask_epi8(_mm_cmpeq_epi8(
+      _mm_max_epu8(shifted, nine), nine));
+   shifted = _mm_sub_epi8(back, zero_char);
+   classes.digits |= (unsigned long) _mm_movemask_epi8(_mm_cmpeq_epi8(
+      _mm_max_epu8(shifted, nine), nine)) << back_offset;
+
+   classes.slashes = (unsigned long) _mm_movemask_epi8(_mm_cmpeq_epi8(front,
+      _mm_set1_epi8('/')));
+
+   classes.pipes = (unsigned long) _mm_movemask_epi8(_mm_cmpeq_epi8(front,
+      _mm_set1_epi8('|')));
+   classes.pipes |= (unsigned long) _mm_movemask_epi8(_mm_cmpeq_epi8(back,
+      _mm_set1_epi8('|'))) << back_offset;
+
+   classes.minus_signs = (unsigned long) _mm_movemask_epi8(_mm_cmpeq_epi8(
+      front, _mm_set1_epi8('-')));
+
+   classes.decimal_points = (unsigned long) _mm_movemask_epi8(_mm_cmpeq_epi8(
+      front, _mm_set1_epi8('.')));
+   classes.decimal_points |= (unsigned long) _mm_movemask_epi8(
+      _mm_cmpeq_epi8(back, _mm_set1_epi8('.'))) << back_offset;
+
+   return check_character_classes(&classes, amount_length);
+}
+
+__attribute__((target("avx2")))
+Bool avx2_scan(const char *line, size_t line_length, size_t *amount_length) {
+
+   __m256i characters;
+   __m256i nine = _mm256_set1_epi8(9);
+   __m256i shifted;
+   Character_classes classes;
+
+   if(line_length < AVX2_SCAN_LENGTH) {
+      return sse2_scan(line, line_length, amount_length);
+   }
+
+   characters = _mm256_loadu_si256((const __m256i *) line);
+
+   shifted = _mm256_sub_epi8(characters, _mm256_set1_epi8('0'));
+   classes.digits = (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(
+      _mm256_max_epu8(shifted, nine), nine));
+   classes.slashes = (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(
+      characters, _mm256_set1_epi8('/')));
+   classes.pipes = (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(
+      characters, _mm256_set1_epi8('|')));
+   classes.minus_signs = (unsigned int) _mm256_movemask_epi8(
+      _mm256_cmpeq_epi8(characters, _mm256_set1_epi8('-')));
+   classes.decimal_points = (unsigned int) _mm256_movemask_epi8(
+      _mm256_cmpeq_epi8(characters, _mm256_set1_epi8('.')));
+
+   return check_character_classes(&classes, amount_length);
+}
+
+#endif
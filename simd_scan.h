@@ -0,0 +1,27 @@
+/*
+ * Name:       simd_scan.h
+ *
+ * Purpose:    Function definitions for simd_scan.c.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#ifndef SIMD_SCAN_H
+
+#define SIMD_SCAN_H
+
+#include <stddef.h>
+#include "boolean.h"
+
+void select_simd_scan(void);
+Bool simd_scan_budget_line(const char *line, size_t line_length,
+   size_t *amount_length);
+
+#endif
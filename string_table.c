@@ -0,0 +1,187 @@
+/*
+ * Name:       string_table.c
+ *
+ * Purpose:    Functions for storing each distinct string once and referring
+ *             to it by a small id.
+ *
+ *             Descriptions such as Rent or Groceries repeat on a great many
+ *             lines of a budget file. Looking one up costs a hash of its
+ *             bytes and usually a single compare, and nothing is allocated
+ *             unless the string is new and the table is out of room.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#include <string.h>
+#include "return_codes.h"
+#include "budget_memory.h"
+#include "hash.h"
+#include "string_table.h"
+
+#define INITIAL_SLOT_COUNT 1024
+#define INITIAL_ENTRY_CAPACITY 512
+#define INITIAL_BYTE_CAPACITY 16384
+
+int grow_slots(String_table *table);
+
+void init_string_table(String_table *table) {
+
+   table->bytes = NULL;
+   table->byte_count = 0;
+   table->byte_capacity = 0;
+   table->entries = NULL;
+   table->entry_count = 0;
+   table->entry_capacity = 0;
+   table->slots = NULL;
+   table->slot_count = 0;
+   table->growth_count = 0;
+}
+
+void free_string_table(String_table *table) {
+
+   budget_free(table->bytes);
+   budget_free(table->entries);
+   budget_free(table->slots);
+
+   init_string_table(table);
+}
+
+/*
+ * Set id to the string's id, adding the string to the table if it isn't
+ * there yet.
+ *
+ * Return 0 if successful. Return MEMORY_ERROR if the table could not be grown
+ * or is full.
+ */
+int intern_string(String_table *table, const char *string, size_t length,
+   Uint32 *id) {
+
+   Uint64 hash = hash_string(string, length);
+   size_t mask;
+   size_t slot;
+   const String_entry *entry;
+   String_entry *new_entry;
+   String_entry *entries;
+   char *bytes;
+
+   if(2 * (table->entry_count + 1) > table->slot_count) {
+      if(grow_slots(table) != 0) {
+         return MEMORY_ERROR;
+      }
+   }
+
+   mask = table->slot_count - 1;
+
+   for(slot = (size_t) hash & mask; table->slots[slot] != 0;
+      slot = (slot + 1) & mask) {
+
+      entry = &table->entries[table->slots[slot] - 1];
+
+      if(entry->hash == hash && entry->length == length
+         && memcmp(table->bytes + entry->offset, string, length) == 0) {
+
+         *id = table->slots[slot] - 1;
+
+         return 0;
+      }
+   }
+
+   if(table->entry_count >= MAX_STRING_COUNT) {
+      return MEMORY_ERROR;
+   }
+
+   entries = grow_array(table->entries, sizeof(String_entry),
+      table->entry_count, &table->entry_capacity, table->entry_count + 1,
+      INITIAL_ENTRY_CAPACITY, &table->growth_count);
+
+   if(entries == NULL) {
+      return MEMORY_ERROR;
+   }
+
+   table->entries = entries;
+
+   bytes = grow_array(table->bytes, 1, table->byte_count,
+      &table->byte_capacity, table->byte_count + length,
+      INITIAL_BYTE_CAPACITY, &table->growth_count);
+
+   if(bytes == NULL) {
+      return MEMORY_ERROR;
+   }
+
+   table->bytes = bytes;
+
+   if(length > 0) {
+      (void) memcpy(table->bytes + table->byte_count, string, length);
+   }
+
+   new_entry = &table->entries[table->entry_count];
+   new_entry->offset = table->byte_count;
+   new_entry->length = length;
+   new_entry->hash = hash;
+
+   table->byte_count += length;
+   *id = (Uint32) table->entry_count++;
+   table->slots[slot] = *id + 1;
+
+   return 0;
+}
+
+/*
+ * Return the string with the given id, which is not null terminated.
+ */
+const char *get_string(const String_table *table, Uint32 id,
+   size_t *length) {
+
+   *length = table->entries[id].length;
+
+   return table->bytes + table->entries[id].offset;
+}
+
+/*
+ * Double the number of slots and put every id back in, using the hashes kept
+ * in the entries.
+ */
+int grow_slots(String_table *table) {
+
+   size_t i;
+   size_t slot;
+   size_t new_slot_count = 2 * table->slot_count;
+   Uint32 *new_slots;
+
+   if(new_slot_count < INITIAL_SLOT_COUNT) {
+      new_slot_count = INITIAL_SLOT_COUNT;
+   }
+
+   new_slots = budget_malloc(new_slot_count * sizeof(Uint32));
+
+   if(new_slots == NULL) {
+      return MEMORY_ERROR;
+   }
+
+   (void) memset(new_slots, 0, new_slot_count * sizeof(Uint32));
+
+   for(i = 0; i < table->entry_count; i++) {
+      slot = (size_t) table->entries[i].hash & (new_slot_count - 1);
+
+      while(new_slots[slot] != 0) {
+         slot = (slot + 1) & (new_slot_count - 1);
+      }
+
+      new_slots[slot] = (Uint32) i + 1;
+   }
+
+   budget_free(table->slots);
+
+   table->slots = new_slots;
+   table->slot_count = new_slot_count;
+   table->growth_count++;
+
+   return 0;
+}
@@ -0,0 +1,63 @@
+/*
+ * Name:       string_table.h
+ *
+ * Purpose:    Typedefs, macros and function definitions for string_table.c.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#ifndef STRING_TABLE_H
+
+#define STRING_TABLE_H
+
+#include <stddef.h>
+#include "integer_types.h"
+
+/*
+ * Most ids a string table can hand out.
+ */
+#define MAX_STRING_COUNT 0x7fffffffUL
+
+typedef struct {
+   size_t offset;
+   size_t length;
+   Uint64 hash;
+} String_entry;
+
+/*
+ * Every distinct string is stored once, one after the other in bytes (not
+ * null terminated), and is given an id counting up from 0 in the order the
+ * strings were first seen. slots is an open-addressing hash table of ids
+ * (plus one, so that 0 means an empty slot) which is never more than half
+ * full.
+ *
+ * growth_count is the number of allocations made so far, all of which
+ * happen when one of the arrays runs out of room and is doubled.
+ */
+typedef struct {
+   char *bytes;
+   size_t byte_count;
+   size_t byte_capacity;
+   String_entry *entries;
+   size_t entry_count;
+   size_t entry_capacity;
+   Uint32 *slots;
+   size_t slot_count;
+   unsigned long growth_count;
+} String_table;
+
+void init_string_table(String_table *table);
+void free_string_table(String_table *table);
+int intern_string(String_table *table, const char *string, size_t length,
+   Uint32 *id);
+const char *get_string(const String_table *table, Uint32 id,
+   size_t *length);
+
+#endif
@@ -0,0 +1,333 @@
+/*
+ * Name:       top_transactions.c
+ *
+ * Purpose:    Functions for keeping the largest credits and debits in a
+ *             budget file.
+ *
+ *             However large the file is, only a fixed number of transactions
+ *             are ever kept. Each heap holds its smallest transaction at the
+ *             top, so a transaction that doesn't make the list is turned away
+ *             with a single comparison, and one that does only moves a
+ *             handful of others out of its way.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#include <string.h>
+#include "return_codes.h"
+#include "budget_memory.h"
+#include "ledger.h"
+#include "top_transactions.h"
+
+int add_to_top_heap(Top_transactions *top, Top_heap *heap,
+   const Top_transaction *transaction);
+Bool is_larger_transaction(const Top_transaction *first,
+   const Top_transaction *second);
+Bool write_top_heap(const Top_heap *heap, FILE *fp);
+int read_top_heap(FILE *fp, Top_transactions *top, Top_heap *heap);
+
+void init_top_transactions(Top_transactions *top, int size) {
+
+   top->size = size;
+   top->transaction_count = 0;
+   top->credits.transactions = NULL;
+   top->credits.count = 0;
+   top->debits.transactions = NULL;
+   top->debits.count = 0;
+   top->growth_count = 0;
+}
+
+void free_top_transactions(Top_transactions *top) {
+
+   budget_free(top->credits.transactions);
+   budget_free(top->debits.transactions);
+
+   init_top_transactions(top, top->size);
+}
+
+/*
+ * Consider transaction for the credits or debits list.
+ *
+ * Return 0 if successful. Return MEMORY_ERROR if the list could not be
+ * allocated.
+ */
+int add_top_transaction(Top_transactions *top,
+   const Transaction *transaction) {
+
+   Top_heap *heap = transaction->amount > 0 ? &top->credits : &top->debits;
+   Top_transaction *smallest = heap->transactions;
+   Top_transaction candidate;
+
+   top->transaction_count++;
+
+   /*
+    * Almost every transaction is smaller than all of the ones on a full
+    * list, so check that before copying anything.
+    */
+   if(heap->count == top->size) {
+      if(transaction->amount > 0 ? transaction->amount <= smallest->amount
+         : transaction->amount >= smallest->amount) {
+
+         return 0;
+      }
+   }
+
+   /*
+    * Whole entries are written to checkpoints, so the padding and the rest
+    * of the description are zeroed rather than left as whatever was there.
+    */
+   (void) memset(&candidate, 0, sizeof(Top_transaction));
+   candidate.amount = transaction->amount;
+   candidate.day_number = DAY_NUMBER(transaction->year, transaction->month,
+      transaction->day);
+   candidate.sequence = top->transaction_count - 1;
+   candidate.description_length = transaction->description_length;
+   (void) memcpy(candidate.description, transaction->description,
+      transaction->description_length);
+
+   return add_to_top_heap(top, heap, &candidate);
+}
+
+/*
+ * Add top into total. The transactions in top are numbered as coming after
+ * all of those in total, so the ledgers must be merged in file order.
+ *
+ * Return 0 if successful. Return MEMORY_ERROR if total could not be
+ * allocated.
+ */
+int merge_top_transactions(Top_transactions *total,
+   const Top_transactions *top) {
+
+   Top_transaction transaction;
+   const Top_heap *heaps[2];
+   int i;
+   int j;
+
+   heaps[0] = &top->credits;
+   heaps[1] = &top->debits;
+
+   for(i = 0; i < 2; i++) {
+      for(j = 0; j < heaps[i]->count; j++) {
+         transaction = heaps[i]->transactions[j];
+         transaction.sequence += total->transaction_count;
+
+         if(add_to_top_heap(total, i == 0 ? &total->credits : &total->debits,
+            &transaction) != 0) {
+
+            return MEMORY_ERROR;
+         }
+      }
+   }
+
+   total->transaction_count += top->transaction_count;
+
+   return 0;
+}
+
+/*
+ * Write the lists to fp. Return FALSE if they could not all be written.
+ */
+Bool write_top_transactions(const Top_transactions *top, FILE *fp) {
+
+   if(fwrite(&top->transaction_count, sizeof(Uint64), 1, fp) != 1
+      || write_top_heap(&top->credits, fp) == FALSE
+      || write_top_heap(&top->debits, fp) == FALSE) {
+
+      return FALSE;
+   }
+
+   return TRUE;
+}
+
+/*
+ * Read lists written by write_top_transactions into top, which must be
+ * empty and the same size as the lists that were written.
+ *
+ * Return 0 if successful. Return FILE_ERROR if fp doesn't hold the lists,
+ * or MEMORY_ERROR if they could not be allocated.
+ */
+int read_top_transactions(FILE *fp, Top_transactions *top) {
+
+   int return_code = 0;
+
+   if(fread(&top->transaction_count, sizeof(Uint64), 1, fp) != 1) {
+      return FILE_ERROR;
+   }
+
+   return_code = read_top_heap(fp, top, &top->credits);
+
+   if(return_code != 0) {
+      return return_code;
+   }
+
+   return read_top_heap(fp, top, &top->debits);
+}
+
+/*
+ * For sorting a list from the largest transaction to the smallest.
+ */
+int compare_top_transactions(const void *first, const void *second) {
+
+   if(is_larger_transaction(first, second) == TRUE) {
+      return -1;
+   }
+
+   if(is_larger_transaction(second, first) == TRUE) {
+      return 1;
+   }
+
+   return 0;
+}
+
+/*
+ * Add transaction to heap if it is larger than the smallest transaction
+ * there, or if there is still room.
+ *
+ * Return 0 if successful. Return MEMORY_ERROR if the heap could not be
+ * allocated.
+ */
+int add_to_top_heap(Top_transactions *top, Top_heap *heap,
+   const Top_transaction *transaction) {
+
+   Top_transaction *transactions;
+   Top_transaction swap;
+   int i;
+   int child;
+
+   if(heap->transactions == NULL) {
+      heap->transactions = budget_malloc(top->size * sizeof(Top_transaction));
+
+      if(heap->transactions == NULL) {
+         return MEMORY_ERROR;
+      }
+
+      top->growth_count++;
+   }
+
+   transactions = heap->transactions;
+
+   /*
+    * Either add it at the bottom and move it up past anything larger...
+    */
+   if(heap->count < top->size) {
+      i = heap->count++;
+      transactions[i] = *transaction;
+
+      while(i > 0 && is_larger_transaction(&transactions[(i - 1) / 2],
+         &transactions[i]) == TRUE) {
+
+         swap = transactions[i];
+         transactions[i] = transactions[(i - 1) / 2];
+         transactions[(i - 1) / 2] = swap;
+         i = (i - 1) / 2;
+      }
+
+      return 0;
+   }
+
+   if(is_larger_transaction(transaction, &transactions[0]) == FALSE) {
+      return 0;
+   }
+
+   /*
+    * ...or put it in place of the smallest and move it down past anything
+    * smaller.
+    */
+   transactions[0] = *transaction;
+   i = 0;
+
+   for(;;) {
+      child = 2 * i + 1;
+
+      if(child >= heap->count) {
+         break;
+      }
+
+      if(child + 1 < heap->count && is_larger_transaction(
+         &transactions[child], &transactions[child + 1]) == TRUE) {
+
+         child++;
+      }
+
+      if(is_larger_transaction(&transactions[i], &transactions[child])
+         == FALSE) {
+
+         break;
+      }
+
+      swap = transactions[i];
+      transactions[i] = transactions[child];
+      transactions[child] = swap;
+      i = child;
+   }
+
+   return 0;
+}
+
+/*
+ * A transaction is larger if its amount is further from zero. Of two with
+ * the same amount, the one that came first is larger, so it is the one kept.
+ */
+Bool is_larger_transaction(const Top_transaction *first,
+   const Top_transaction *second) {
+
+   Cents first_size = first->amount > 0 ? first->amount : -first->amount;
+   Cents second_size = second->amount > 0 ? second->amount : -second->amount;
+
+   if(first_size != second_size) {
+      return first_size > second_size ? TRUE : FALSE;
+   }
+
+   return first->sequence < second->sequence ? TRUE : FALSE;
+}
+
+Bool write_top_heap(const Top_heap *heap, FILE *fp) {
+
+   Int32 count = heap->count;
+
+   if(fwrite(&count, sizeof(Int32), 1, fp) != 1) {
+      return FALSE;
+   }
+
+   if(count > 0 && fwrite(heap->transactions, sizeof(Top_transaction),
+      (size_t) count, fp) != (size_t) count) {
+
+      return FALSE;
+   }
+
+   return TRUE;
+}
+
+int read_top_heap(FILE *fp, Top_transactions *top, Top_heap *heap) {
+
+   Top_transaction transaction;
+   Int32 count;
+   Int32 i;
+
+   if(fread(&count, sizeof(Int32), 1, fp) != 1 || count < 0
+      || count > top->size) {
+
+      return FILE_ERROR;
+   }
+
+   for(i = 0; i < count; i++) {
+      if(fread(&transaction, sizeof(Top_transaction), 1, fp) != 1
+         || transaction.description_length >= LINE_BUFFER_SIZE) {
+
+         return FILE_ERROR;
+      }
+
+      if(add_to_top_heap(top, heap, &transaction) != 0) {
+         return MEMORY_ERROR;
+      }
+   }
+
+   return 0;
+}
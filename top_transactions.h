@@ -0,0 +1,79 @@
+/*
+ * Name:       top_transactions.h
+ *
+ * Purpose:    Typedefs, macros and function definitions for
+ *             top_transactions.c.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#ifndef TOP_TRANSACTIONS_H
+
+#define TOP_TRANSACTIONS_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include "boolean.h"
+#include "integer_types.h"
+#include "size_limits.h"
+#include "cents.h"
+#include "transaction.h"
+
+/*
+ * Most transactions that can be listed with --top.
+ */
+#define MAX_TOP_COUNT 1000
+
+/*
+ * A transaction kept for the list. sequence is the number of transactions
+ * that came before it, which decides between transactions with the same
+ * amount. The description is copied, since the line it came from is gone
+ * by the time the list is printed.
+ */
+typedef struct {
+   Cents amount;
+   int day_number;
+   Uint64 sequence;
+   size_t description_length;
+   char description[LINE_BUFFER_SIZE];
+} Top_transaction;
+
+/*
+ * The largest transactions seen so far, kept as a heap with the smallest of
+ * them first so it is the one to drop when a larger one comes along.
+ */
+typedef struct {
+   Top_transaction *transactions;
+   int count;
+} Top_heap;
+
+/*
+ * The size largest credits and the size largest debits (furthest below
+ * zero). Each heap is only allocated once something is added to it.
+ */
+typedef struct {
+   int size;
+   Uint64 transaction_count;
+   Top_heap credits;
+   Top_heap debits;
+   unsigned long growth_count;
+} Top_transactions;
+
+void init_top_transactions(Top_transactions *top, int size);
+void free_top_transactions(Top_transactions *top);
+int add_top_transaction(Top_transactions *top,
+   const Transaction *transaction);
+int merge_top_transactions(Top_transactions *total,
+   const Top_transactions *top);
+Bool write_top_transactions(const Top_transactions *top, FILE *fp);
+int read_top_transactions(FILE *fp, Top_transactions *top);
+int compare_top_transactions(const void *first, const void *second);
+
+#endif
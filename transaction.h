@@ -0,0 +1,38 @@
+/*
+ * Name:       transaction.h
+ *
+ * Purpose:    Typedef for a single budget transaction, as produced by the
+ *             line parser and consumed by the budget calculations.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#ifndef TRANSACTION_H
+
+#define TRANSACTION_H
+
+#include <stddef.h>
+#include "cents.h"
+
+/*
+ * A validated line from the budget file. The description is not copied; it
+ * points into the line it was parsed from and is only valid for as long as
+ * that line is.
+ */
+typedef struct {
+   int month;
+   int day;
+   int year;
+   Cents amount;
+   const char *description;
+   size_t description_length;
+} Transaction;
+
+#endif
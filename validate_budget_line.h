@@ -1,26 +1,57 @@
-/*
- * Name:       validate_budget_line.h
- *
- * Purpose:    Macros and function definitions for validating a line from the
- *             budget file.
- *
- * Author:     jjones4
- *
- * Copyright (c) 2024 Jerad Jones
- *
- * This file is part of c_budget. c_budget may be freely distributed under the
- * MIT license. For all details and documentation, see:
- *
- *             https://github.com/jjones4/c_budget
- */
-
-#ifndef VALIDATE_BUDGET_LINE_H
-
-#define VALIDATE_BUDGET_LINE_H
-
-/*
- * Macros and functions used for validating a line from the budget file.
- */
-int validate_budget_line(char **line, int line_number);
-
-#endif
\ No newline at end of file
+/*
+ * Name:       validate_budget_line.h
+ *
+ * Purpose:    Macros and function definitions for validating a line from the
+ *             budget file.
+ *
+ * Author:     jjones4
+ *
+ * Copyright (c) 2024 Jerad Jones
+ *
+ * This file is part of c_budget. c_budget may be freely distributed under the
+ * MIT license. For all details and documentation, see:
+ *
+ *             https://github.com/jjones4/c_budget
+ */
+
+#ifndef VALIDATE_BUDGET_LINE_H
+
+#define VALIDATE_BUDGET_LINE_H
+
+#include <stddef.h>
+#include "boolean.h"
+#include "integer_types.h"
+#include "transaction.h"
+
+/*
+ * Reasons a line can fail validation, returned by parse_budget_line. They are
+ * listed in the order the checks are made, so a line with more than one
+ * problem always reports the first one in this list.
+ */
+#define LINE_TERMINATION_ERROR 1
+#define LINE_FORMAT_ERROR 2
+#define DATE_FORMAT_ERROR 3
+#define AMOUNT_FORMAT_ERROR 4
+#define DATE_CHARACTER_ERROR 5
+#define AMOUNT_CHARACTER_ERROR 6
+#define MONTH_CONVERSION_ERROR 7
+#define DAY_CONVERSION_ERROR 8
+#define YEAR_CONVERSION_ERROR 9
+#define AMOUNT_CONVERSION_ERROR 10
+#define MONTH_RANGE_ERROR 11
+#define DAY_RANGE_ERROR 12
+
+/*
+ * Macros and functions used for validating a line from the budget file.
+ */
+int parse_budget_line(const char *line, size_t line_length,
+   Transaction *transaction);
+void print_validation_error(int validation_error, const char *file_name,
+   Uint64 line_number);
+const char *get_validation_error_reason(int validation_error);
+Bool parse_amount(const char *amount_string, size_t amount_length,
+   Cents *amount);
+Bool parse_date(const char *date_string, int *month, int *day, int *year);
+Bool is_valid_day(const int month, const int day, const int year);
+
+#endif